@@ -40,6 +40,26 @@ char *adecl(IR *irObject) {
                      irObject->ir.memoryData);
             return str;
         }
+        case SYSTEM: {
+            char *str;
+            System_IR *systemIR = &irObject->ir.systemIR;
+            switch (systemIR->type) {
+                case SYSTEM_HLT:
+                    if (systemIR->data.imm16 == SEMIHOSTING_HLT) return strdup("Semihosting call");
+                    asprintf(&str,
+                             "Halt #0x%04x",
+                             systemIR->data.imm16);
+                    break;
+
+                case SYSTEM_MRS:
+                    asprintf(&str,
+                             "R%d = %s count",
+                             systemIR->data.mrs.rt,
+                             systemIR->data.mrs.sysreg == PMCCNTR_EL0 ? "cycle" : "instruction");
+                    break;
+            }
+            return str;
+        }
     }
     return "";
 }
@@ -360,7 +380,7 @@ static char *adeclLoadStore(LoadStore_IR loadStoreIr) {
                          "%s R%d = M[PC + 4 * '%s']",
                          nBits,
                          loadStoreIr.rt,
-                         loadStoreIr.data.simm19.data.label);
+                         loadStoreIr.data.simm19.data.label.name);
             } else {
                 asprintf(&str,
                          "%s R%d = M[PC + 4 * %d]",
@@ -386,7 +406,7 @@ static char *adeclBranch(Branch_IR branchIr) {
             if (branchIr.data.simm26.isLabel) {
                 asprintf(&str,
                          "Jump to '%s'",
-                         branchIr.data.simm26.data.label);
+                         branchIr.data.simm26.data.label.name);
             } else {
                 asprintf(&str,
                          "Jump %d lines",
@@ -407,7 +427,7 @@ static char *adeclBranch(Branch_IR branchIr) {
                 asprintf(&str,
                          "If %s, jump to '%s'",
                          getBranchCondition(branchIr.data.conditional.condition),
-                         branchIr.data.conditional.simm19.data.label);
+                         branchIr.data.conditional.simm19.data.label.name);
             } else {
                 asprintf(&str,
                          "If %s, jump %d lines",
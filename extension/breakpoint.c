@@ -0,0 +1,121 @@
+///
+/// breakpoint.c
+/// Line breakpoints for debug mode, and the PC-indexed map which checks them.
+///
+
+#include "breakpoint.h"
+
+/// The textual operators of [Comparison], indexed by it.
+static const char *operators[] = {
+    [CMP_EQ] = "==", [CMP_NE] = "!=", [CMP_LT] = "<", [CMP_LE] = "<=", [CMP_GT] = ">", [CMP_GE] = ">="
+};
+
+/// Parses a condition of the form <xN op value> or <wN op value>, e.g., <x1 == 0x10>.
+/// An empty condition makes the breakpoint unconditional.
+/// @param text The condition to parse.
+/// @param[out] breakpoint The enabled [Breakpoint], if the condition is valid.
+/// @returns Whether the condition is valid.
+bool parseCondition(const char *text, Breakpoint *breakpoint) {
+    char width, operator[3];
+    unsigned reg;
+    BitData value;
+    int consumed = 0;
+
+    if (strspn(text, " ") == strlen(text)) {
+        *breakpoint = (Breakpoint) { .enabled = true, .conditional = false };
+        return true;
+    }
+
+    if (sscanf(text, " %c%u %2[=!<>] %" SCNi64 " %n", &width, &reg, operator, (int64_t *) &value, &consumed) != 4
+        || text[consumed] != '\0' || (tolower(width) != 'x' && tolower(width) != 'w') || reg > 31) {
+        return false;
+    }
+
+    for (size_t i = 0; i < sizeof(operators) / sizeof(char *); i++) {
+        if (!strcmp(operator, operators[i])) {
+            *breakpoint = (Breakpoint) {
+                .enabled = true, .conditional = true, .sf = tolower(width) == 'x', .reg = reg, .comparison = i, .value = value
+            };
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// Formats the condition of a [Breakpoint], as accepted by [parseCondition].
+/// @param breakpoint The [Breakpoint] to format.
+/// @param buffer The buffer to write to, which is empty for an unconditional breakpoint.
+/// @param size The size of [buffer].
+void formatBreakpoint(const Breakpoint *breakpoint, char *buffer, size_t size) {
+    if (!breakpoint->enabled || !breakpoint->conditional) {
+        snprintf(buffer, size, "%s", "");
+        return;
+    }
+
+    snprintf(buffer, size, "%c%d %s 0x%" PRIx64, breakpoint->sf ? 'x' : 'w', breakpoint->reg,
+             operators[breakpoint->comparison], breakpoint->value);
+}
+
+/// Creates an empty [BreakpointMap] for a program of [count] instructions.
+/// @param count The number of instructions in the program.
+/// @returns The [BreakpointMap], which must be freed with [freeBreakpointMap].
+BreakpointMap createBreakpointMap(size_t count) {
+    BreakpointMap map = {
+        .bits = calloc(count / 64 + 1, sizeof(uint64_t)),
+        .breakpoints = malloc((count + 1) * sizeof(Breakpoint)),
+        .count = count
+    };
+    assert(map.bits != NULL && map.breakpoints != NULL);
+    return map;
+}
+
+/// Sets or clears the breakpoint of the instruction at [address].
+/// @param map The [BreakpointMap] to modify.
+/// @param address The address of the instruction.
+/// @param breakpoint The [Breakpoint] of the instruction, which clears it if not enabled.
+void setBreakpoint(BreakpointMap *map, BitData address, const Breakpoint *breakpoint) {
+    BitData index = address / 0x4;
+    if (index >= map->count) return;
+
+    map->breakpoints[index] = *breakpoint;
+    if (breakpoint->enabled) {
+        map->bits[index / 64] |= (uint64_t) 1 << (index % 64);
+    } else {
+        map->bits[index / 64] &= ~((uint64_t) 1 << (index % 64));
+    }
+}
+
+/// Checks whether the condition of a [Breakpoint] holds.
+/// @param breakpoint The enabled [Breakpoint] to check.
+/// @param regs The current state of the registers.
+/// @returns Whether the breakpoint should break.
+bool conditionHolds(const Breakpoint *breakpoint, Registers regs) {
+    if (!breakpoint->conditional) return true;
+
+    BitData reg = getReg(regs, breakpoint->reg);
+    BitData value = breakpoint->value;
+    if (!breakpoint->sf) {
+        reg = (uint32_t) reg;
+        value = (uint32_t) value;
+    }
+
+    switch (breakpoint->comparison) {
+        case CMP_EQ: return reg == value;
+        case CMP_NE: return reg != value;
+        case CMP_LT: return reg < value;
+        case CMP_LE: return reg <= value;
+        case CMP_GT: return reg > value;
+        case CMP_GE: return reg >= value;
+    }
+
+    return true;
+}
+
+/// Frees the memory of a [BreakpointMap].
+/// @param map The [BreakpointMap] to free.
+void freeBreakpointMap(BreakpointMap *map) {
+    free(map->bits);
+    free(map->breakpoints);
+    *map = (BreakpointMap) { .bits = NULL, .breakpoints = NULL, .count = 0 };
+}
@@ -0,0 +1,87 @@
+///
+/// breakpoint.h
+/// Line breakpoints for debug mode, and the PC-indexed map which checks them.
+///
+
+#ifndef EXTENSION_BREAKPOINT_H
+#define EXTENSION_BREAKPOINT_H
+
+#include <assert.h>
+#include <ctype.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "const.h"
+#include "registers.h"
+
+/// The comparison of a conditional [Breakpoint].
+typedef enum {
+    CMP_EQ, ///< ==
+    CMP_NE, ///< !=
+    CMP_LT, ///< <
+    CMP_LE, ///< <=
+    CMP_GT, ///< >
+    CMP_GE  ///< >=
+} Comparison;
+
+/// A breakpoint on a line, which may only break when a register compares to a value.
+typedef struct {
+    /// Whether the line has a breakpoint.
+    bool enabled;
+
+    /// Whether the breakpoint only breaks when [reg] [comparison] [value] holds.
+    bool conditional;
+
+    /// Whether the register is read as 64-bit.
+    bool sf;
+
+    /// The register to compare, where 31 is the zero register.
+    uint8_t reg;
+
+    /// How to compare the register to [value].
+    Comparison comparison;
+
+    /// The value to compare the register to, unsigned.
+    BitData value;
+} Breakpoint;
+
+/// The breakpoints of a program, indexed by instruction address / 4.
+typedef struct {
+    /// One bit per instruction, set if it has a [Breakpoint].
+    uint64_t *bits;
+
+    /// The [Breakpoint] of each instruction, valid where its bit is set.
+    Breakpoint *breakpoints;
+
+    /// The number of instructions in the map.
+    size_t count;
+} BreakpointMap;
+
+bool parseCondition(const char *text, Breakpoint *breakpoint);
+
+void formatBreakpoint(const Breakpoint *breakpoint, char *buffer, size_t size);
+
+BreakpointMap createBreakpointMap(size_t count);
+
+void setBreakpoint(BreakpointMap *map, BitData address, const Breakpoint *breakpoint);
+
+bool conditionHolds(const Breakpoint *breakpoint, Registers regs);
+
+void freeBreakpointMap(BreakpointMap *map);
+
+/// Checks whether the instruction at the PC has a breakpoint which should break.
+/// Inlined, as it is checked after every instruction while continuing.
+/// @param map The [BreakpointMap] to check.
+/// @param regs The current state of the registers.
+/// @returns Whether execution should stop.
+static inline bool breakpointHit(const BreakpointMap *map, Registers regs) {
+    BitData index = getRegPC(regs) / 0x4;
+    if (index >= map->count || !((map->bits[index / 64] >> (index % 64)) & 1)) return false;
+    return conditionHolds(&map->breakpoints[index], regs);
+}
+
+#endif // EXTENSION_BREAKPOINT_H
@@ -11,8 +11,36 @@ static void initialise(const char *path);
 
 static void updateUI(void);
 
+static void updateTitle(const char *state);
+
+static void pollRun(Run *run);
+
+static void syncBreakpoint(int lineNumber);
+
+static void parseFileLine(int lineNumber, AssemblerState *state);
+
+static bool acceptCondition(const char *input, void *breakpoint);
+
+static bool acceptWatchpoint(const char *input, void *memory);
+
+static bool acceptAddress(const char *input, void *context);
+
+static bool acceptPattern(const char *input, void *pattern);
+
+static bool acceptText(const char *input, void *text);
+
+static void searchFile(void);
+
+static void startBackgroundSave(void);
+
+static void finishBackgroundSave(void);
+
+static int waitForKey(void);
+
 static void printSpaced(WINDOW *window, int row, int count, char **content);
 
+static void freeDebugSession(void);
+
 int main(int argc, char *argv[]) {
     initialise((argc > 1) ? argv[1] : NULL);
 
@@ -22,9 +50,6 @@ int main(int argc, char *argv[]) {
     // Has the debug mode terminated execution?
     bool finishedExecuting = false;
 
-    // The memory for debug mode.
-    Memory debugMemory;
-
     int key = -1;
     while (key != QUIT_KEY) {
         // Don't update the UI if we just ran the code.
@@ -34,13 +59,22 @@ int main(int argc, char *argv[]) {
         justRan = false;
 
         // Get and handle input.
-        key = wgetch(editor);
+        key = waitForKey();
+
+        // A message in the help bar only lasts until the next key press.
+        if (helpMessage[0] != '\0') {
+            helpMessage[0] = '\0';
+            damage |= DAMAGE_HELP;
+        }
 
         switch (key) {
             case SAVE_KEY:
-                status = (file->path)
-                         ? (saveFile(file) ? SAVED : status)
-                         : (showSaveOverlay(file) ? SAVED : status);
+                if (file->path) {
+                    startBackgroundSave();
+                } else {
+                    status = showSaveOverlay(file) ? SAVED : status;
+                    damage |= DAMAGE_SCREEN;
+                }
                 break;
 
             case RUN_KEY: {
@@ -48,6 +82,7 @@ int main(int argc, char *argv[]) {
 
                 // Initialise registers, memory, and assembler state.
                 Registers_s registersStruct = createRegs();
+                resetMachine();
                 Registers registers = &registersStruct;
                 Memory memory = allocMem();
                 AssemblerState state = createState();
@@ -59,7 +94,7 @@ int main(int argc, char *argv[]) {
 
                     // Perform the first assembly pass.
                     for (int currentLine = 0; currentLine < file->size; currentLine++) {
-                        parse(getLine(file->lines[currentLine]), &state);
+                        parseFileLine(currentLine, &state);
                     }
 
                     state.address = 0x0;
@@ -72,20 +107,20 @@ int main(int argc, char *argv[]) {
                         state.address += 0x4;
                     }
 
-                    // Fetch first instruction.
-                    Instruction instruction = readMem(memory, false, getRegPC(registers));
-
-                    // Fetch, decode, execute cycle while the program has not terminated.
-                    while (instruction != HALT) {
-                        execute(&instruction, registers, memory);
-                    }
-
+                    // Execute on a worker thread, until the program terminates or a key is pressed.
+                    Run run;
+                    startRun(&run, registersStruct, memory, NULL);
+                    pollRun(&run);
+                    registersStruct = run.registers;
                 }
 
-                // Display the register states.
+                // Display the register states, until the next key press draws the lines over them.
                 updateDebug(registers);
+                damage |= DAMAGE_LINES;
 
-                wmove(editor, file->lineNumber, file->cursor);
+                wmove(editor, file->lineNumber - file->windowY, file->cursor);
+                wnoutrefresh(editor);
+                doupdate();
 
                 // Free the emulator and assembler states.
                 freeMem(memory);
@@ -100,14 +135,14 @@ int main(int argc, char *argv[]) {
 
             case DEBUG_KEY:
                 finishedExecuting = false;
+                damage |= DAMAGE_LINES | DAMAGE_SIDE;
 
                 // Toggle debug mode.
                 if (mode == DEBUG) {
                     // If manually exiting debug, terminate the execution.
                     mode = EDIT;
                     status = UNSAVED;
-                    freeMem(debugMemory);
-                    free(addrLines);
+                    freeDebugSession();
                     clearLastRegs();
                     break;
                 } else {
@@ -115,15 +150,17 @@ int main(int argc, char *argv[]) {
                     status = READ_ONLY;
                 }
 
-                // Initialise the addrLines array.
-                addrLines = malloc(file->size * sizeof(AddrLine));
-
-                // The index of the current instruction
-                int instructionIndex = 0;
+                // Initialise the address maps. Each line compiles to at most one instruction.
+                addressLines = malloc(file->size * sizeof(size_t));
+                lineAddresses = malloc(file->size * sizeof(BitData));
+                assert(addressLines != NULL && lineAddresses != NULL);
+                addressCount = 0;
 
                 // Initialise registers, memory, and assembler state.
                 debugRegistersStruct = createRegs();
+                resetMachine();
                 debugMemory = allocMem();
+                clearMemorySnapshot();
                 AssemblerState state = createState();
 
                 // Initialise error string.
@@ -135,18 +172,14 @@ int main(int argc, char *argv[]) {
                     for (int currentLine = 0; currentLine < file->size; currentLine++) {
                         size_t irCount = state.irCount;
 
-                        parse(getLine(file->lines[currentLine]), &state);
+                        parseFileLine(currentLine, &state);
 
+                        // Remember the association between the line number and the memory
+                        // address of its compiled instruction, in both directions.
+                        lineAddresses[currentLine] = NO_ADDRESS;
                         if (irCount != state.irCount) {
-                            // Add a new addrLine if the line compiles.
-                            // This will remember the association between the line number
-                            // and the memory address of its compiled instruction.
-                            AddrLine addrLine;
-                            addrLine.line = currentLine;
-                            addrLine.address = instructionIndex * 4;
-                            addrLines[instructionIndex] = addrLine;
-
-                            instructionIndex++;
+                            lineAddresses[currentLine] = addressCount * 0x4;
+                            addressLines[addressCount++] = currentLine;
                         }
                     }
 
@@ -160,6 +193,12 @@ int main(int argc, char *argv[]) {
                         state.address += 0x4;
                     }
 
+                    // Mark the instructions of the lines with breakpoints.
+                    breakpointMap = createBreakpointMap(addressCount);
+                    for (int currentLine = 0; currentLine < file->size; currentLine++) {
+                        syncBreakpoint(currentLine);
+                    }
+
                     destroyState(state);
 
                     pcValue = 0x0;
@@ -170,21 +209,88 @@ int main(int argc, char *argv[]) {
                     updateDebug(&debugRegistersStruct);
 
                     // Free the memory
-                    freeMem(debugMemory);
-                    free(addrLines);
+                    freeDebugSession();
 
                     finishedExecuting = true;
                 }
 
                 break;
 
+            case BREAKPOINT_KEY: {
+                Breakpoint *breakpoint = &lineAt(file, file->lineNumber)->breakpoint;
+                *breakpoint = (Breakpoint) { .enabled = !breakpoint->enabled };
+                syncBreakpoint(file->lineNumber);
+                lineAt(file, file->lineNumber)->drawnRow = NOT_DRAWN;
+                break;
+            }
+
+            case CONDITION_KEY: {
+                Breakpoint *breakpoint = &lineAt(file, file->lineNumber)->breakpoint;
+                char condition[MAX_PROMPT_LENGTH];
+                formatBreakpoint(breakpoint, condition, sizeof(condition));
+                showPromptOverlay("Break When", "[ Expected <xN op value>, where op is one of == != < <= > >= ]",
+                                  condition, acceptCondition, breakpoint);
+                syncBreakpoint(file->lineNumber);
+                lineAt(file, file->lineNumber)->drawnRow = NOT_DRAWN;
+                damage |= DAMAGE_SCREEN;
+                break;
+            }
+
+            case SEARCH_KEY:
+                if (status != READ_ONLY) searchFile();
+                break;
+
+            case REPLACE_KEY: {
+                if (status == READ_ONLY) break;
+
+                char pattern[MAX_PROMPT_LENGTH], replacement[MAX_PROMPT_LENGTH];
+                damage |= DAMAGE_SCREEN;
+                if (!showPromptOverlay("Replace", "[ Expected some text to replace ]", "", acceptPattern, pattern)
+                    || !showPromptOverlay("With", "", "", acceptText, replacement)) {
+                    break;
+                }
+
+                // Replace every occurrence at once, rather than editing the file key by key.
+                int count = replaceInFile(file, pattern, replacement);
+                if (count > 0) status = UNSAVED;
+                snprintf(helpMessage, sizeof(helpMessage), "REPLACED %d OCCURRENCE%s", count, count == 1 ? "" : "S");
+
+                // The line under the cursor may have become shorter.
+                int length;
+                peekLine(file, file->lineNumber, &length);
+                if (file->cursor > length) file->cursor = length;
+                break;
+            }
+
             case BINARY_KEY:
                 // Toggle binary mode.
                 mode = (mode == BINARY) ? EDIT : BINARY;
+                damage |= DAMAGE_LINES;
                 break;
 
             default:
-                if (mode == DEBUG && key == '\n') {
+                if (mode == DEBUG && key == WATCH_KEY && !finishedExecuting) {
+                    showPromptOverlay("Watch", "[ Expected <address> or <address:length>, with at most 16 watched ]", "",
+                                      acceptWatchpoint, debugMemory);
+                    damage |= DAMAGE_SCREEN;
+                    break;
+                }
+
+                if (mode == DEBUG && debugMemory != NULL && (key == KEY_NPAGE || key == KEY_PPAGE)) {
+                    scrollMemory(key == KEY_NPAGE ? 1 : -1);
+                    damage |= DAMAGE_SIDE;
+                    break;
+                }
+
+                if (mode == DEBUG && debugMemory != NULL && key == GOTO_KEY) {
+                    showPromptOverlay("Go To", "[ Expected an address, in decimal or hexadecimal (0x) ]", "",
+                                      acceptAddress, NULL);
+                    damage |= DAMAGE_SCREEN | DAMAGE_SIDE;
+                    break;
+                }
+
+                if (mode == DEBUG && (key == '\n' || key == CONTINUE_KEY)) {
+                    damage |= DAMAGE_LINES | DAMAGE_SIDE;
                     if (finishedExecuting) {
                         // If the program finished execution because of a fatal error.
                         mode = EDIT;
@@ -192,7 +298,7 @@ int main(int argc, char *argv[]) {
                         clearLastRegs();
                         break;
                     }
-                    // Run the current instruction.
+                    // Run the current instruction, or continue to the next breakpoint.
 
                     // Fetch instruction.
                     Instruction instruction = readMem(debugMemory, false, getRegPC(&debugRegistersStruct));
@@ -201,25 +307,48 @@ int main(int argc, char *argv[]) {
                     if (instruction == HALT) {
                         mode = EDIT;
                         status = UNSAVED;
-                        freeMem(debugMemory);
-                        free(addrLines);
+                        freeDebugSession();
                         clearLastRegs();
                         break;
                     }
 
-                    // Execute the instruction.
-                    execute(&instruction, &debugRegistersStruct, debugMemory);
+                    // Remember the memory shown, to highlight the words this step changes.
+                    snapshotMemory(debugMemory);
+
+                    bool errored = false;
+                    WatchpointHit hit;
+                    bool watched = false;
+                    if (key == CONTINUE_KEY) {
+                        // Run flat-out on a worker thread, which checks the breakpoints after every instruction.
+                        Run run;
+                        startRun(&run, debugRegistersStruct, debugMemory, &breakpointMap);
+                        pollRun(&run);
+                        debugRegistersStruct = run.registers;
+                        errored = run.errored;
+                        watched = run.watched;
+                        hit = run.watchpointHit;
+                    } else if (!setjmp(fatalBuffer)) {
+                        // Execute the instruction.
+                        execute(&instruction, &debugRegistersStruct, debugMemory);
+                        watched = takeWatchpointHit(&hit);
+                    } else {
+                        errored = true;
+                    }
+                    setWatchpointHit(watched ? &hit : NULL);
+
+                    if (errored) {
+                        // Fatal error encountered during execution, which the side window displays.
+                        freeDebugSession();
+                        finishedExecuting = true;
+                        break;
+                    }
                     finishedExecuting = false;
 
                     pcValue = getRegPC(&debugRegistersStruct);
 
                     // Scroll to the line now being executed.
-                    for (int addrLineIndex = 0; addrLineIndex < file->size; addrLineIndex++) {
-                        AddrLine currAddrLine = addrLines[addrLineIndex];
-                        if (currAddrLine.address == pcValue) {
-                            file->lineNumber = currAddrLine.line;
-                            break;
-                        }
+                    if (pcValue % 0x4 == 0 && pcValue / 0x4 < addressCount) {
+                        file->lineNumber = addressLines[pcValue / 0x4];
                     }
 
                     break;
@@ -232,10 +361,13 @@ int main(int argc, char *argv[]) {
         }
     }
 
-    // Automatically save the file if it is unsaved.
-    status = (file->path)
-        ? (saveFile(file) ? SAVED : status)
-        : (showSaveOverlay(file) ? SAVED : status);
+    // Automatically save the file if it is unsaved, once any save in the background has finished.
+    if (saving) finishBackgroundSave();
+    if (status != SAVED) {
+        status = (file->path)
+            ? (saveFile(file) ? SAVED : status)
+            : (showSaveOverlay(file) ? SAVED : status);
+    }
 
     // Cleanup
     freeFile(file);
@@ -249,19 +381,48 @@ int main(int argc, char *argv[]) {
 /// @param line The line to rerender.
 /// @param index The index of the line in the window.
 static void rerenderLineWrapper(Line *line, int index) {
-    bool currentDebugLine = false;
     // Determine if the current line is the one being debugged.
-    for (int addrLineIndex = 0; addrLineIndex < file->size; addrLineIndex++) {
-        AddrLine currAddrLine = addrLines[addrLineIndex];
-        if (currAddrLine.line == (size_t) index && currAddrLine.address == pcValue) {
-            currentDebugLine = true;
-            break;
-        }
-        if (currAddrLine.line > (size_t) index) break;
-    }
+    bool currentDebugLine = lineAddresses != NULL && lineAddresses[index] == pcValue;
     rerenderLine(line, index, false, currentDebugLine);
 }
 
+/// Frees the memory being debugged, and the maps between addresses, lines, and breakpoints built for it.
+static void freeDebugSession(void) {
+    if (debugMemory != NULL) {
+        clearWatchpoints();
+        freeMem(debugMemory);
+        debugMemory = NULL;
+    }
+
+    free(addressLines);
+    free(lineAddresses);
+    addressLines = NULL;
+    lineAddresses = NULL;
+    addressCount = 0;
+    freeBreakpointMap(&breakpointMap);
+}
+
+/// Copies the breakpoint of a line into [breakpointMap], if debug mode has mapped the line to an instruction.
+/// Lines which have not been read in cannot have had a breakpoint set.
+/// @param lineNumber The index of the line.
+static void syncBreakpoint(int lineNumber) {
+    if (lineAddresses == NULL || lineAddresses[lineNumber] == NO_ADDRESS) return;
+    if (file->lines[lineNumber] == NULL) return;
+    setBreakpoint(&breakpointMap, lineAddresses[lineNumber], &file->lines[lineNumber]->breakpoint);
+}
+
+/// Parses a line of [file] into [state], without reading it into a [Line] if it has not been already.
+/// @param lineNumber The index of the line.
+/// @param state The [AssemblerState] to modify.
+static void parseFileLine(int lineNumber, AssemblerState *state) {
+    int length;
+    const char *text = peekLine(file, lineNumber, &length);
+    const char *end = text + length;
+    while (text != end) {
+        text = parseLine(text, end, state);
+    }
+}
+
 /// Initialises the editor.
 /// @param path The path to the file to open, or NULL if no file is to be opened.
 static void initialise(const char *path) {
@@ -285,6 +446,7 @@ static void initialise(const char *path) {
     init_pair(SELECTED_SCHEME, 2, 16);
     init_pair(ERROR_SCHEME, 196, 16);
     init_pair(I_ERROR_SCHEME, 16, 196);
+    init_pair(BREAKPOINT_SCHEME, 16, 214);
 
     title = newwin(TITLE_HEIGHT, cols, 0, 0);
     wbkgd(title, COLOR_PAIR(MENU_SCHEME));
@@ -320,13 +482,16 @@ static void initialise(const char *path) {
 }
 
 /// Updates UI, including line numbers window, scrolling.
+/// Only the parts of the screen which have changed, or which [damage] marks, are drawn again, and they are all sent
+/// to the terminal in a single update.
 static void updateUI(void) {
     // Check if the terminal size has changed.
     int oldRows = rows, oldCols = cols;
     getmaxyx(stdscr, rows, cols);
     if (rows < MINIMUM_HEIGHT || cols < MINIMUM_WIDTH) {
+        // The overlay only returns once the terminal is large enough again.
         showTermSizeOverlay();
-        return;
+        damage |= DAMAGE_SCREEN;
     }
 
     // Resize all windows if size has changed.
@@ -348,6 +513,7 @@ static void updateUI(void) {
         werase(title);
         wresize(title, TITLE_HEIGHT, cols);
         mvwin(title, 0, 0);
+        drawnTitle[0][0] = '\0';
 
         werase(help);
         wresize(help, MENU_HEIGHT, cols);
@@ -356,34 +522,9 @@ static void updateUI(void) {
         werase(separator);
         wresize(separator, CONTENT_HEIGHT, 1);
         mvwin(separator, TITLE_HEIGHT, cols / 2);
-    }
 
-    // Update top title bar.
-    char **buffer = (char **) malloc(5 * sizeof(char *));
-    wattron(title, A_BOLD);
-
-    asprintf(&buffer[0], "[GRIM]");
-    asprintf(&buffer[1], "MODE: %s", modes[mode]);
-    asprintf(&buffer[2], "%s", file->path ? basename(file->path) : "untitled.s");
-    asprintf(&buffer[3], "STATUS: %s", statuses[status]);
-    asprintf(&buffer[4], "[%d, %d]", file->lineNumber + 1, file->cursor + 1);
-    werase(title);
-    printSpaced(title, 0, 5, buffer);
-
-    wattroff(title, A_BOLD);
-    for (int i = 1; i < 5; i++) free(buffer[i]);
-    wrefresh(title);
-
-    // Update bottom help bar.
-    wattron(help, A_BOLD);
-    werase(help);
-    printSpaced(help, 0, 5, (char **) commands);
-    wattroff(help, A_BOLD);
-    wrefresh(help);
-
-    // Update separator.
-    mvwvline(separator, TITLE_HEIGHT - 1, 0, ACS_VLINE, CONTENT_HEIGHT);
-    wrefresh(separator);
+        damage |= DAMAGE_SCREEN | DAMAGE_LINES | DAMAGE_SIDE;
+    }
 
     // Scroll if out of bounds in any direction.
     if (file->lineNumber >= file->windowY + CONTENT_HEIGHT) {
@@ -413,8 +554,41 @@ static void updateUI(void) {
         mvwin(lineNumbers, TITLE_HEIGHT, 0);
         wresize(editor, CONTENT_HEIGHT, cols / 2 - maxWidth - 1);
         mvwin(editor, TITLE_HEIGHT, maxWidth + 1);
+        damage |= DAMAGE_SCREEN | DAMAGE_LINES;
+    }
+
+    // Whatever was drawn over the windows must be replaced by their contents.
+    if (damage & DAMAGE_SCREEN) {
+        touchwin(title);
+        touchwin(side);
+        touchwin(lineNumbers);
+        touchwin(editor);
+
+        // Update separator.
+        mvwvline(separator, TITLE_HEIGHT - 1, 0, ACS_VLINE, CONTENT_HEIGHT);
+        wnoutrefresh(separator);
     }
 
+    // Update bottom help bar, with the commands unless there is a message.
+    if (damage & (DAMAGE_SCREEN | DAMAGE_HELP)) {
+        wattron(help, A_BOLD);
+        werase(help);
+        if (helpMessage[0] != '\0') {
+            mvwaddstr(help, 0, 0, helpMessage);
+        } else {
+            printSpaced(help, 0, 5, (char **) commands);
+        }
+        wattroff(help, A_BOLD);
+        wnoutrefresh(help);
+    }
+
+    // Update top title bar.
+    char state[TITLE_PART_LENGTH];
+    snprintf(state, sizeof(state), "STATUS: %s", statuses[status]);
+    updateTitle(state);
+
+    if (damage & DAMAGE_LINES) invalidateWindow(file);
+
     switch (mode) {
         case EDIT:
             updateEdit();
@@ -425,25 +599,240 @@ static void updateUI(void) {
             break;
 
         case DEBUG:
-            // Print out all lines in current window.
-            iterateLinesInWindow(file, &rerenderLineWrapper);
-
-            // Update the side window.
-            updateDebug(&debugRegistersStruct);
+            // Print out the lines in the current window which have changed.
+            iterateChangedLinesInWindow(file, &rerenderLineWrapper);
+
+            // Update the side window, with as much memory as fits below the registers.
+            if (damage & DAMAGE_SIDE) {
+                updateDebug(&debugRegistersStruct);
+                if (debugMemory != NULL) updateMemory(debugMemory, getcury(side) + 2);
+                wclrtobot(side);
+            }
             break;
     }
 
-    wclrtobot(side);
-    wrefresh(side);
+    // Clear all unoccupied space below the file in the line number, editor, and line-by-line side windows.
+    int endRow = file->size - file->windowY;
+    if (endRow < CONTENT_HEIGHT) {
+        wmove(lineNumbers, endRow, 0);
+        wclrtobot(lineNumbers);
+        wmove(editor, endRow, 0);
+        wclrtobot(editor);
+        if (mode != DEBUG) {
+            wmove(side, endRow, 0);
+            wclrtobot(side);
+        }
+    }
 
-    // Clear all unoccupied space in line number and editor windows.
-    wclrtobot(lineNumbers);
-    wrefresh(lineNumbers);
-    wclrtobot(editor);
+    wnoutrefresh(side);
+    wnoutrefresh(lineNumbers);
 
     // Move cursor to new position.
     wmove(editor, file->lineNumber - file->windowY, file->cursor);
-    wrefresh(editor);
+    wnoutrefresh(editor);
+
+    doupdate();
+    damage = 0;
+}
+
+/// Updates the top title bar, if its text has changed.
+/// @param state The text describing the status of the file, or of a run.
+/// @remark The title bar is only copied to the virtual screen; call [doupdate] to send it to the terminal.
+static void updateTitle(const char *state) {
+    char text[5][TITLE_PART_LENGTH];
+    snprintf(text[0], TITLE_PART_LENGTH, "[GRIM]");
+    snprintf(text[1], TITLE_PART_LENGTH, "MODE: %s", modes[mode]);
+    snprintf(text[2], TITLE_PART_LENGTH, "%s", file->path ? basename(file->path) : "untitled.s");
+    snprintf(text[3], TITLE_PART_LENGTH, "%s", state);
+    snprintf(text[4], TITLE_PART_LENGTH, "[%d, %d]", file->lineNumber + 1, file->cursor + 1);
+
+    bool changed = false;
+    for (int i = 0; i < 5; i++) {
+        if (strcmp(text[i], drawnTitle[i]) != 0) {
+            strcpy(drawnTitle[i], text[i]);
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        char *buffer[5] = { text[0], text[1], text[2], text[3], text[4] };
+        wattron(title, A_BOLD);
+        werase(title);
+        printSpaced(title, 0, 5, buffer);
+        wattroff(title, A_BOLD);
+    }
+    wnoutrefresh(title);
+}
+
+/// Sets a [Breakpoint] from the condition entered into its prompt.
+/// @param input The condition, as accepted by [parseCondition].
+/// @param breakpoint The [Breakpoint] to set.
+/// @returns Whether the condition was valid.
+static bool acceptCondition(const char *input, void *breakpoint) {
+    return parseCondition(input, (Breakpoint *) breakpoint);
+}
+
+/// Watches the range of memory entered into its prompt.
+/// @param input The range, as accepted by [parseWatchpoint].
+/// @param memory The memory being debugged.
+/// @returns Whether the range was valid, and there was room to watch it.
+static bool acceptWatchpoint(const char *input, void *memory) {
+    size_t address, length;
+    return parseWatchpoint(input, &address, &length) && addWatchpoint(memory, address, length);
+}
+
+/// Shows the memory at an address typed into the Go To prompt.
+/// @param input The address.
+/// @param context Unused.
+/// @returns Whether [input] was an address in RAM.
+static bool acceptAddress(const char *input, unused void *context) {
+    char *end;
+    errno = 0;
+    unsigned long long address = strtoull(input, &end, 0);
+    if (errno != 0 || end == input || *end != '\0' || address >= MEMORY_SIZE) return false;
+
+    showMemoryAt(address);
+    return true;
+}
+
+/// Copies the text to replace, typed into the Replace prompt.
+/// @param input The text to replace.
+/// @param pattern The buffer of [MAX_PROMPT_LENGTH] characters to copy it into.
+/// @returns Whether [input] was not empty.
+static bool acceptPattern(const char *input, void *pattern) {
+    if (input[0] == '\0') return false;
+    return acceptText(input, pattern);
+}
+
+/// Copies the text typed into a prompt.
+/// @param input The text.
+/// @param text The buffer of [MAX_PROMPT_LENGTH] characters to copy it into.
+/// @returns [true], as any text is accepted.
+static bool acceptText(const char *input, void *text) {
+    snprintf(text, MAX_PROMPT_LENGTH, "%s", input);
+    return true;
+}
+
+/// Searches the file as a pattern is typed into the help bar, moving the cursor to its first occurrence at or after
+/// where the search began. [SEARCH_KEY] moves on to the next occurrence, [ENTER] stays at the current one, and
+/// [ESC] returns to where the search began.
+static void searchFile(void) {
+    int startLine = file->lineNumber, startColumn = file->cursor;
+    char pattern[MAX_PROMPT_LENGTH] = "";
+    int length = 0;
+    bool found = true;
+
+    while (true) {
+        snprintf(helpMessage, sizeof(helpMessage), "SEARCH: %s%s", pattern, found ? "" : " [NOT FOUND]");
+        damage |= DAMAGE_HELP;
+        updateUI();
+
+        int key = wgetch(editor);
+        int lineNumber = startLine, column = startColumn;
+        if (key == '\n' || key == KEY_ENTER) {
+            break;
+        } else if (key == 27) { // ESC key
+            file->lineNumber = startLine;
+            file->cursor = startColumn;
+            break;
+        } else if (key == SEARCH_KEY) {
+            if (length == 0) continue;
+            lineNumber = file->lineNumber;
+            column = file->cursor + 1;
+        } else if (key == KEY_BACKSPACE || key == 127) {
+            if (length > 0) pattern[--length] = '\0';
+        } else if (isprint(key) && length + 1 < MAX_PROMPT_LENGTH) {
+            pattern[length++] = key;
+            pattern[length] = '\0';
+        } else {
+            continue;
+        }
+
+        // An empty pattern matches where the search began.
+        found = length == 0 || findInFile(file, pattern, &lineNumber, &column);
+        if (found) {
+            file->lineNumber = lineNumber;
+            file->cursor = column;
+        }
+    }
+
+    helpMessage[0] = '\0';
+    damage |= DAMAGE_HELP;
+}
+
+/// Starts saving a snapshot of the file to its path in the background, after any save already being written.
+/// The file stays [SAVING] until the save finishes, unless it is changed in the meantime.
+static void startBackgroundSave(void) {
+    if (saving) finishBackgroundSave();
+
+    startSave(&backgroundSave, file);
+    saving = true;
+    if (status != READ_ONLY) status = SAVING;
+}
+
+/// Waits for the save in the background to finish, and marks the file [SAVED] if it has not changed since.
+static void finishBackgroundSave(void) {
+    bool saved = finishSave(&backgroundSave);
+    saving = false;
+    if (status == SAVING) status = saved ? SAVED : UNSAVED;
+}
+
+/// Waits for a key press in the editor window. While a save is being written in the background, the title bar is
+/// updated as soon as it finishes, rather than at the next key press.
+/// @returns The key pressed.
+static int waitForKey(void) {
+    int key = ERR;
+    wtimeout(editor, SAVE_POLL_MS);
+    while (saving && key == ERR) {
+        key = wgetch(editor);
+        if (!atomic_load(&backgroundSave.finished)) continue;
+
+        finishBackgroundSave();
+        char state[TITLE_PART_LENGTH];
+        snprintf(state, sizeof(state), "STATUS: %s", statuses[status]);
+        updateTitle(state);
+
+        // Leave the cursor in the editor window.
+        wnoutrefresh(editor);
+        doupdate();
+    }
+    wtimeout(editor, -1);
+
+    return (key == ERR) ? wgetch(editor) : key;
+}
+
+/// Waits for a started [Run], publishing the number of instructions executed and the instructions per second
+/// to the title bar, until the program terminates or a key is pressed, then summarises how the run ended.
+/// @param run The [Run] to wait for, which is stopped on return.
+static void pollRun(Run *run) {
+    // Poll for a key press, so the title bar is refreshed whenever none arrives.
+    bool stopped = false;
+    wtimeout(editor, RUN_REFRESH_MS);
+    while (!atomic_load(&run->finished)) {
+        if (wgetch(editor) != ERR) {
+            stopped = true;
+            break;
+        }
+        if (atomic_load(&run->finished)) break;
+
+        uint64_t executed = atomic_load_explicit(&run->executed, memory_order_relaxed);
+
+        char progress[TITLE_PART_LENGTH];
+        snprintf(progress, sizeof(progress), "RUNNING: %" PRIu64 " (%.0f IPS)",
+                 executed, executed / secondsSince(&run->start));
+        updateTitle(progress);
+        doupdate();
+    }
+    wtimeout(editor, -1);
+
+    stopRun(run);
+    uint64_t executed = atomic_load(&run->executed);
+
+    char summary[TITLE_PART_LENGTH];
+    const char *outcome = run->errored ? "ERRORED" : stopped ? "STOPPED" : "RAN";
+    snprintf(summary, sizeof(summary), "%s: %" PRIu64 " (%.0f IPS)", outcome, executed, executed / run->seconds);
+    updateTitle(summary);
+    doupdate();
 }
 
 /// Prints the given [...] strings equally spaced.
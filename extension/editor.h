@@ -8,6 +8,7 @@
 #ifndef EXTENSION_EDITOR_H
 #define EXTENSION_EDITOR_H
 
+#include <errno.h>
 #include <libgen.h>
 #include <ncurses.h>
 #include <setjmp.h>
@@ -15,6 +16,7 @@
 
 #include "assemblerDelegate.h"
 #include "binarySide.h"
+#include "breakpoint.h"
 #include "debugSide.h"
 #include "const.h"
 #include "editSide.h"
@@ -23,13 +25,14 @@
 #include "file.h"
 #include "highlight.h"
 #include "line.h"
+#include "memorySide.h"
+#include "promptOverlay.h"
+#include "runner.h"
 #include "saveOverlay.h"
+#include "saver.h"
 #include "state.h"
 #include "termSizeOverlay.h"
 
-/// The halt instruction for run/debug mode.
-#define HALT 0x8a000000
-
 /// The key-code for CTRL plus some other key.
 #define CTRL(__KEY__) ((__KEY__) & 0x1F)
 
@@ -48,6 +51,51 @@
 /// The key code to view the compiled assembly.
 #define BINARY_KEY        CTRL('b')
 
+/// The key code to toggle a breakpoint on the current line.
+#define BREAKPOINT_KEY    CTRL('t')
+
+/// The key code to set a conditional breakpoint on the current line.
+#define CONDITION_KEY     CTRL('k')
+
+/// The key code to search the file as the pattern is typed.
+#define SEARCH_KEY        CTRL('f')
+
+/// The key code to replace every occurrence of some text in the file.
+#define REPLACE_KEY       CTRL('p')
+
+/// The key code to continue to the next breakpoint in debug mode.
+#define CONTINUE_KEY      'c'
+
+/// The key code to watch a range of memory for writes in debug mode.
+#define WATCH_KEY         'w'
+
+/// The key code to go to an address in the memory panel in debug mode.
+#define GOTO_KEY          'g'
+
+/// The interval, in milliseconds, at which a run's progress is shown in the title bar.
+#define RUN_REFRESH_MS    50
+
+/// The interval, in milliseconds, at which a save in the background is checked for having finished.
+#define SAVE_POLL_MS      50
+
+/// The maximum length of each piece of text in the title bar.
+#define TITLE_PART_LENGTH 64
+
+/// The parts of the screen which [updateUI] must draw again, beyond the lines it finds have changed.
+typedef enum {
+    /// Every line in the window, with its line number and any side panel row.
+    DAMAGE_LINES  = 1 << 0,
+
+    /// The side panel of debug mode.
+    DAMAGE_SIDE   = 1 << 1,
+
+    /// The whole screen, which was overwritten by an overlay or resized.
+    DAMAGE_SCREEN = 1 << 2,
+
+    /// The help bar, whose message has changed.
+    DAMAGE_HELP   = 1 << 3,
+} Damage;
+
 static const char *commands[6] = {
     "[^Q] - QUIT",
     "[^S] - SAVE",
@@ -61,7 +109,7 @@ static const char *commands[6] = {
 static const char *modes[] = { "EDIT", "DEBUG", "BINARY" };
 
 /// The human-readable titles of [EditorStatus].
-static const char *statuses[] = { "READ ONLY", "UNSAVED", "SAVED" };
+static const char *statuses[] = { "READ ONLY", "UNSAVED", "SAVING", "SAVED" };
 
 int rows = 0, cols = 0;
 
@@ -75,8 +123,20 @@ EditorMode mode;
 /// The current editor status.
 EditorStatus status;
 
-/// Info about the lines after attempt to assemble.
-LineInfo *lineInfo;
+/// The save being written in the background, if [saving].
+Save backgroundSave;
+
+/// Whether [backgroundSave] has been started and not yet finished.
+bool saving = false;
+
+/// The [Damage] to the screen since [updateUI] last drew it.
+Damage damage = DAMAGE_SCREEN;
+
+/// The pieces of text in the title bar as last drawn, so that it is only drawn again when they change.
+char drawnTitle[5][TITLE_PART_LENGTH];
+
+/// The message shown in the help bar in place of the commands, if it is not empty.
+char helpMessage[TITLE_PART_LENGTH + MAX_PROMPT_LENGTH];
 
 /// Current PC value for debug mode.
 BitData pcValue;
@@ -84,16 +144,23 @@ BitData pcValue;
 /// The registers for debug mode.
 Registers_s debugRegistersStruct;
 
-/// Associate instruction memory address with the line number it corresponds to.
-typedef struct {
-    /// The address of the instruction in memory.
-    BitData address;
-    /// The index of the line whose binary instruction is stored at the address.
-    size_t line;
-} AddrLine;
+/// The memory for debug mode, or [NULL] if nothing is being debugged.
+Memory debugMemory;
+
+/// The address standing for no instruction in [lineAddresses].
+#define NO_ADDRESS UINT64_MAX
+
+/// The line of each instruction in debug mode, indexed by its address / 4.
+size_t *addressLines;
+
+/// The number of instructions in [addressLines].
+size_t addressCount;
+
+/// The address of the instruction on each line in debug mode, or [NO_ADDRESS] if it has none.
+BitData *lineAddresses;
 
-/// List of memory addresses and line numbers they correspond to, for debug mode.
-AddrLine *addrLines;
+/// The breakpoints of the instructions in debug mode.
+BreakpointMap breakpointMap;
 
 /// The flag signifying whether the current line has errored.
 bool lineErrored = false;
@@ -7,42 +7,63 @@
 
 #include "file.h"
 
-/// Creates a new [File]. If [path] is not NULL, copies in its contents.
+static void indexLines(File *file, int lineNumber);
+
+/// Creates a new [File]. If [path] is not NULL, maps in its contents.
+/// Only the number of lines is counted up front; each line is indexed and read into a [Line] when first needed.
 /// @param path The path of the file to read in. Leave [NULL] if not present.
 /// @returns A pointer to the new [File].
 File *initialiseFile(const char *path) {
     File *file = (File *) malloc(sizeof(File));
 
     file->size = 0;
-    file->maxSize = INITIAL_FILE_SIZE;
     file->lineNumber = 0;
     file->cursor = 0;
     file->windowX = 0;
     file->windowY = 0;
+    file->drawnWindowY = NOT_DRAWN;
+    file->drawnLineNumber = 0;
 
-    file->lines = (Line **) malloc(INITIAL_FILE_SIZE * sizeof(Line *));
     file->path = path ? strdup(path) : NULL;
+    file->original = NULL;
+    file->originalLength = 0;
+    file->indexed = 0;
+    file->scanOffset = 0;
 
     if (file->path != NULL) {
-        FILE *handler = fopen(file->path, "r");
-        assert(handler != NULL);
-
-        char *text = NULL;
-        size_t textLength = 0;
-        ssize_t read;
-
-        while ((read = getline(&text, &textLength, handler)) != -1) {
-            if (text[read - 1] == '\n') text[--read] = '\0';
-            addLine(file, text, file->size - 1);
+        int descriptor = open(file->path, O_RDONLY);
+        assert(descriptor != -1);
+
+        struct stat info;
+        assert(fstat(descriptor, &info) == 0);
+        file->originalLength = info.st_size;
+
+        // Empty files cannot be mapped, but have no lines to map anyway.
+        if (file->originalLength > 0) {
+            void *original = mmap(NULL, file->originalLength, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            assert(original != MAP_FAILED);
+            file->original = original;
         }
+        close(descriptor);
 
-        free(text);
-        fclose(handler);
-    } else {
-        // Add a blank line to start.
-        addLine(file, NULL, 0);
+        // Every newline ends a line, and so does the end of the file if no newline does.
+        const char *cursor = file->original, *end = file->original + file->originalLength;
+        while (cursor < end && (cursor = memchr(cursor, '\n', end - cursor)) != NULL) {
+            cursor++;
+            file->size++;
+        }
+        if (file->originalLength > 0 && end[-1] != '\n') file->size++;
     }
 
+    // No line has been read in yet. Their starts are indexed in [indexLines].
+    file->maxSize = (file->size > INITIAL_FILE_SIZE) ? file->size : INITIAL_FILE_SIZE;
+    file->lines = (Line **) calloc(file->maxSize, sizeof(Line *));
+    file->lineStarts = (size_t *) malloc(file->maxSize * sizeof(size_t));
+    assert(file->lines != NULL && file->lineStarts != NULL);
+
+    // Add a blank line to start.
+    if (file->size == 0) addLine(file, NULL, 0);
+
     return file;
 }
 
@@ -55,9 +76,63 @@ void freeFile(File *file) {
         freeLine(file->lines[i]);
     }
     free(file->lines);
+    free(file->lineStarts);
+    if (file->original != NULL) munmap((void *) file->original, file->originalLength);
     free(file);
 }
 
+/// Extends the index of line starts in [original] to cover line [lineNumber].
+/// Lines past [indexed] are always the original lines following [scanOffset], in order.
+/// @param file The [File] to index.
+/// @param lineNumber The line which must be indexed.
+static void indexLines(File *file, int lineNumber) {
+    for (; file->indexed <= lineNumber && file->indexed < file->size; file->indexed++) {
+        file->lineStarts[file->indexed] = file->scanOffset;
+
+        const char *start = file->original + file->scanOffset;
+        const char *newline = memchr(start, '\n', file->originalLength - file->scanOffset);
+        file->scanOffset = (newline != NULL) ? (size_t) (newline + 1 - file->original) : file->originalLength;
+    }
+}
+
+/// Gets the text of a line, without reading it into a [Line] if it has not been already.
+/// @param file The [File] containing the line.
+/// @param lineNumber The line number of the line.
+/// @param[out] length The number of characters in the line.
+/// @returns The text of the line, which is not null-terminated, and valid until the line is next modified.
+const char *peekLine(File *file, int lineNumber, int *length) {
+    assert(lineNumber < file->size);
+
+    Line *line = file->lines[lineNumber];
+    if (line != NULL) {
+        *length = lineLength(line);
+        return viewLine(line);
+    }
+
+    indexLines(file, lineNumber);
+    size_t start = file->lineStarts[lineNumber];
+    const char *text = file->original + start;
+    const char *newline = memchr(text, '\n', file->originalLength - start);
+    *length = (newline != NULL) ? newline - text : (int) (file->originalLength - start);
+    return text;
+}
+
+/// Gets the [Line] at a line number, reading it in from the original file if it has not been already.
+/// @param file The [File] containing the line.
+/// @param lineNumber The line number of the line.
+/// @returns The [Line].
+Line *lineAt(File *file, int lineNumber) {
+    assert(lineNumber < file->size);
+
+    Line *line = file->lines[lineNumber];
+    if (line == NULL) {
+        int length;
+        const char *text = peekLine(file, lineNumber, &length);
+        line = file->lines[lineNumber] = initialiseLineFrom(text, length);
+    }
+    return line;
+}
+
 /// Adds a new [Line] containing [content] after line number [afterLine].
 /// @param file The [File] to modify.
 /// @param content The text to add.
@@ -66,21 +141,24 @@ void addLine(File *file, const char *content, int afterLine) {
     assert(afterLine <= file->size);
 
     Line *newLine = initialiseLine(content);
+    int index = (afterLine == file->size) ? file->size : afterLine + 1;
+
+    // Keep the lines which are not yet indexed in their original order, after every line that has been.
+    indexLines(file, index - 1);
 
     if (file->size >= file->maxSize) {
         file->maxSize *= 2; // Exponential scaling policy.
         file->lines = (Line **) realloc(file->lines, file->maxSize * sizeof(Line *));
-        assert(file->lines != NULL);
+        file->lineStarts = (size_t *) realloc(file->lineStarts, file->maxSize * sizeof(size_t));
+        assert(file->lines != NULL && file->lineStarts != NULL);
+        memset(&file->lines[file->size], 0, (file->maxSize - file->size) * sizeof(Line *));
     }
 
-    if (afterLine == file->size) {
-        file->lines[file->size++] = newLine;
-    } else {
-        memmove(&file->lines[afterLine + 2], &file->lines[afterLine + 1],
-                (file->size - afterLine - 1) * sizeof(Line *));
-        file->lines[afterLine + 1] = newLine;
-        file->size++;
-    }
+    memmove(&file->lines[index + 1], &file->lines[index], (file->size - index) * sizeof(Line *));
+    memmove(&file->lineStarts[index + 1], &file->lineStarts[index], (file->indexed - index) * sizeof(size_t));
+    file->lines[index] = newLine;
+    file->size++;
+    file->indexed++;
 }
 
 /// Deletes a [Line] at a given line number from the [File].
@@ -88,11 +166,16 @@ void addLine(File *file, const char *content, int afterLine) {
 /// @param lineNumber The line number to delete.
 void deleteLine(File *file, int lineNumber) {
     assert(lineNumber < file->size);
+    indexLines(file, lineNumber);
 
     freeLine(file->lines[lineNumber]);
     memmove(&file->lines[lineNumber], &file->lines[lineNumber + 1], (file->size - lineNumber - 1) * sizeof(Line *));
+    memmove(&file->lineStarts[lineNumber], &file->lineStarts[lineNumber + 1],
+            (file->indexed - lineNumber - 1) * sizeof(size_t));
 
     file->size--;
+    file->indexed--;
+    file->lines[file->size] = NULL;
 }
 
 /// Executes [callback] on every line in the [File].
@@ -100,7 +183,7 @@ void deleteLine(File *file, int lineNumber) {
 /// @param callback The [LineCallback] to execute on each line.
 void iterateLines(File *file, LineCallback callback) {
     for (int i = 0; i < file->size; ++i) {
-        callback(file->lines[i], i);
+        callback(lineAt(file, i), i);
     }
 }
 
@@ -108,9 +191,38 @@ void iterateLines(File *file, LineCallback callback) {
 /// @param file The [File] to process.
 /// @param callback The [LineCallback] to execute on the lines.
 void iterateLinesInWindow(File *file, LineCallback callback) {
-    for (int i = (int) file->windowY; i < (int) file->size; i++) {
-        callback(file->lines[i], i);
+    for (int i = (int) file->windowY; i < (int) file->size && i < file->windowY + CONTENT_HEIGHT; i++) {
+        callback(lineAt(file, i), i);
+    }
+}
+
+/// Executes [callback] on the lines in the window which have changed since they were last drawn, i.e., those which
+/// were edited, moved to another row, or which the cursor moved onto or off. Every line has changed if the window
+/// scrolled, or was invalidated.
+/// @param file The [File] to process.
+/// @param callback The [LineCallback] which draws a line.
+void iterateChangedLinesInWindow(File *file, LineCallback callback) {
+    bool scrolled = file->windowY != file->drawnWindowY;
+    bool cursorMoved = file->lineNumber != file->drawnLineNumber;
+
+    for (int i = file->windowY; i < file->size && i < file->windowY + CONTENT_HEIGHT; i++) {
+        Line *line = lineAt(file, i);
+        int row = i - file->windowY;
+        if (scrolled || line->drawnRow != row
+            || (cursorMoved && (i == file->lineNumber || i == file->drawnLineNumber))) {
+            callback(line, i);
+            line->drawnRow = row;
+        }
     }
+
+    file->drawnWindowY = file->windowY;
+    file->drawnLineNumber = file->lineNumber;
+}
+
+/// Marks every line in the window as changed, so that [iterateChangedLinesInWindow] draws them all again.
+/// @param file The [File] to invalidate.
+void invalidateWindow(File *file) {
+    file->drawnWindowY = NOT_DRAWN;
 }
 
 /// Performs some action of [file] given some [key].
@@ -122,8 +234,8 @@ bool handleFileAction(File *file, int key) {
         case KEY_UP:
             if (file->lineNumber == 0) return false;
             file->lineNumber--;
-            if (file->cursor >= lineLength(file->lines[file->lineNumber])) {
-                file->cursor = lineLength(file->lines[file->lineNumber]);
+            if (file->cursor >= lineLength(lineAt(file, file->lineNumber))) {
+                file->cursor = lineLength(lineAt(file, file->lineNumber));
             }
             break;
 
@@ -132,7 +244,7 @@ bool handleFileAction(File *file, int key) {
             // the down arrow on the last line of the file.
             if (file->lineNumber + 1 == file->size) {
                 // But if they are already on a trailing empty line, return.
-                if (!lineLength(file->lines[file->lineNumber])) return false;
+                if (!lineLength(lineAt(file, file->lineNumber))) return false;
 
                 addLine(file, NULL, file->lineNumber++);
                 file->cursor = 0;
@@ -141,8 +253,8 @@ bool handleFileAction(File *file, int key) {
 
             // Otherwise, go to the next line and coerce cursor x location.
             file->lineNumber++;
-            if (file->cursor >= lineLength(file->lines[file->lineNumber])) {
-                file->cursor = lineLength(file->lines[file->lineNumber]);
+            if (file->cursor >= lineLength(lineAt(file, file->lineNumber))) {
+                file->cursor = lineLength(lineAt(file, file->lineNumber));
             }
 
             break;
@@ -153,14 +265,14 @@ bool handleFileAction(File *file, int key) {
                 if (file->lineNumber == 0) return false;
 
                 file->lineNumber--;
-                file->cursor = lineLength(file->lines[file->lineNumber]);
+                file->cursor = lineLength(lineAt(file, file->lineNumber));
             } else {
                 file->cursor--;
             }
             break;
 
         case KEY_RIGHT:
-            if (file->cursor >= lineLength(file->lines[file->lineNumber])) {
+            if (file->cursor >= lineLength(lineAt(file, file->lineNumber))) {
                 // Go to end of previous line if it exists.
                 if (file->lineNumber + 1 == file->size) return false;
 
@@ -173,7 +285,7 @@ bool handleFileAction(File *file, int key) {
 
         case '\n': {
             // Save the contents of the current one, and remove after cursor.
-            Line *currentLine = file->lines[file->lineNumber];
+            Line *currentLine = lineAt(file, file->lineNumber);
             char *currentText = getLine(currentLine);
             removeStrAt(currentLine, file->cursor, lineLength(currentLine));
 
@@ -188,13 +300,13 @@ bool handleFileAction(File *file, int key) {
         case 127: // [DEL] key.
             if (file->cursor > 0) {
                 // Remove the character at the cursor position
-                removeStrAt(file->lines[file->lineNumber], file->cursor - 1, file->cursor);
+                removeStrAt(lineAt(file, file->lineNumber), file->cursor - 1, file->cursor);
                 file->cursor--;
                 return true;
             } else if (file->cursor == 0 && file->lineNumber > 0) {
                 // Current line will be removed, but we copy over text.
-                Line *currentLine = file->lines[file->lineNumber];
-                Line *previousLine = file->lines[file->lineNumber - 1];
+                Line *currentLine = lineAt(file, file->lineNumber);
+                Line *previousLine = lineAt(file, file->lineNumber - 1);
                 int previousLineLength = lineLength(previousLine);
 
                 if (lineLength(currentLine) != 0) {
@@ -212,13 +324,13 @@ bool handleFileAction(File *file, int key) {
             return false;
 
         case '\t':
-            insertStrAt(file->lines[file->lineNumber], "  ", file->cursor);
+            insertStrAt(lineAt(file, file->lineNumber), "  ", file->cursor);
             file->cursor += 2;
             return true;
 
         default:
             if (!isprint(key)) return false;
-            insertCharAt(file->lines[file->lineNumber], key, file->cursor);
+            insertCharAt(lineAt(file, file->lineNumber), key, file->cursor);
             file->cursor++;
             return true;
     }
@@ -226,17 +338,89 @@ bool handleFileAction(File *file, int key) {
     return false;
 }
 
-bool saveFile(File *file) {
-    FILE *f = fopen(file->path, "w");
-    if (f == NULL) return false;
+/// Finds the next occurrence of [pattern] at or after a position, wrapping around past the end of the file.
+/// Lines are searched with [memmem] where they lie, without being read in.
+/// @param file The [File] to search.
+/// @param pattern The text to find, which must not be empty.
+/// @param[in,out] lineNumber The line at which to start, then the line of the occurrence.
+/// @param[in,out] column The column at which to start, then the column of the occurrence.
+/// @returns Whether [pattern] occurs in [file]. If not, [lineNumber] and [column] are unchanged.
+bool findInFile(File *file, const char *pattern, int *lineNumber, int *column) {
+    size_t patternLength = strlen(pattern);
+
+    // The starting line is searched from [column] first, and again from its start after wrapping around.
+    for (int i = 0; i <= file->size; i++) {
+        int current = (*lineNumber + i) % file->size;
+        int from = (i == 0) ? *column : 0;
+
+        int length;
+        const char *text = peekLine(file, current, &length);
+        if (from > length) continue;
+
+        const char *match = memmem(text + from, length - from, pattern, patternLength);
+        if (match != NULL) {
+            *lineNumber = current;
+            *column = match - text;
+            return true;
+        }
+    }
 
-    for (int i = 0; i < file->size; ++i) {
-        char *lineText = getLine(file->lines[i]);
-        fprintf(f, "%s\n", lineText);
+    return false;
+}
+
+/// Replaces every occurrence of [pattern] with [replacement] in a single pass over [file].
+/// Only the lines which contain [pattern] are read in, and each is rewritten once.
+/// @param file The [File] to modify.
+/// @param pattern The text to replace, which must not be empty.
+/// @param replacement The text to replace it with.
+/// @returns The number of occurrences replaced.
+int replaceInFile(File *file, const char *pattern, const char *replacement) {
+    size_t patternLength = strlen(pattern);
+    size_t replacementLength = strlen(replacement);
+
+    int count = 0;
+    char *buffer = NULL;
+    size_t capacity = 0;
+
+    for (int i = 0; i < file->size; i++) {
+        int length;
+        const char *text = peekLine(file, i, &length);
+        const char *end = text + length;
+        const char *match = memmem(text, length, pattern, patternLength);
+        if (match == NULL) continue;
+
+        // Build the replaced line, copying the text between occurrences.
+        size_t used = 0;
+        const char *cursor = text;
+        for (; match != NULL; match = memmem(cursor, end - cursor, pattern, patternLength)) {
+            size_t needed = used + (match - cursor) + replacementLength + (end - match) + 1;
+            if (needed > capacity) {
+                capacity = (needed > capacity * 2) ? needed : capacity * 2; // Exponential scaling policy.
+                buffer = realloc(buffer, capacity);
+                assert(buffer != NULL);
+            }
+
+            memcpy(buffer + used, cursor, match - cursor);
+            used += match - cursor;
+            memcpy(buffer + used, replacement, replacementLength);
+            used += replacementLength;
+            cursor = match + patternLength;
+            count++;
+        }
+        memcpy(buffer + used, cursor, end - cursor);
+        used += end - cursor;
+        buffer[used] = '\0';
+
+        if (file->lines[i] == NULL) {
+            file->lines[i] = initialiseLineFrom(buffer, used);
+        } else {
+            removeStrAt(file->lines[i], 0, length);
+            insertStrAt(file->lines[i], buffer, 0);
+        }
     }
 
-    fclose(f);
-    return true;
+    free(buffer);
+    return count;
 }
 
 /// Updates the contents of one line, with corresponding line number.
@@ -259,7 +443,12 @@ void rerenderLine(Line *line, int index, bool errored, bool currentDebug) {
 
     if (!errored || file->lineNumber == index) {
 
-        if (file->lineNumber == index) {
+        if (line->breakpoint.enabled) {
+            // Display the line number of a breakpoint in its own colour, wherever the cursor is.
+            wattron(lineNumbers, COLOR_PAIR(BREAKPOINT_SCHEME));
+            mvwprintw(lineNumbers, index - file->windowY, padding, "%d", index + 1);
+            wattroff(lineNumbers, COLOR_PAIR(BREAKPOINT_SCHEME));
+        } else if (file->lineNumber == index) {
             // Display editor line with highlighting if the cursor is on that line.
             wattron(lineNumbers, COLOR_PAIR(SELECTED_SCHEME));
             mvwprintw(lineNumbers, index - file->windowY, padding, "%d", index + 1);
@@ -272,11 +461,11 @@ void rerenderLine(Line *line, int index, bool errored, bool currentDebug) {
         if (currentDebug) {
             // Highlight the line in black and white if it's currently being debugged.
             wattron(editor, COLOR_PAIR(I_DEFAULT_SCHEME));
-            waddstr(editor, getLine(line));
+            waddstr(editor, viewLine(line));
             wattroff(editor, COLOR_PAIR(I_DEFAULT_SCHEME));
         } else {
             // Syntax highlight the line
-            wPrintLine(editor, getLine(line));
+            wPrintLine(editor, viewLine(line), &line->highlight);
         }
     } else {
         // Print the line number in red.
@@ -286,7 +475,7 @@ void rerenderLine(Line *line, int index, bool errored, bool currentDebug) {
 
         // Display editor line in red.
         wattron(editor, COLOR_PAIR(ERROR_SCHEME));
-        wprintw(editor, "%s", getLine(line));
+        waddstr(editor, viewLine(line));
         wattroff(editor, COLOR_PAIR(ERROR_SCHEME));
     }
 
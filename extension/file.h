@@ -9,7 +9,11 @@
 #define EXTENSION_FILE_H
 
 #include <ctype.h>
+#include <fcntl.h>
 #include <ncurses.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "const.h"
 #include "line.h"
@@ -17,13 +21,30 @@
 
 #define INITIAL_FILE_SIZE 8
 /// Overall representation of a text file.
+/// The original contents are mapped into memory, and a line is only read into a [Line] when it is first needed,
+/// so that opening a file costs memory in proportion to the lines viewed and edited, rather than to its size.
 typedef struct {
     /// Path to the file.
     char *path;
 
-    /// The individual lines of text.
+    /// The original contents of the file, or [NULL] if there were none.
+    const char *original;
+
+    /// The number of characters in [original].
+    size_t originalLength;
+
+    /// The individual lines of text, or [NULL] for lines which are only in [original]. Use [lineAt] to read them.
     Line **lines;
 
+    /// The offset in [original] at which each line starts, for the first [indexed] lines not in [lines].
+    size_t *lineStarts;
+
+    /// The number of lines, from the first, which have been indexed in [lineStarts] or added.
+    int indexed;
+
+    /// The offset in [original] of the first line not yet [indexed].
+    size_t scanOffset;
+
     /// The number of lines.
     int size;
 
@@ -38,6 +59,12 @@ typedef struct {
 
     /// The top-left corner of the window currently being rendered.
     int windowX, windowY;
+
+    /// The [windowY] at which the window was last drawn, or [NOT_DRAWN] if every line must be drawn again.
+    int drawnWindowY;
+
+    /// The [lineNumber] at which the window was last drawn.
+    int drawnLineNumber;
 } File;
 
 typedef void (*LineCallback)(Line *line, int index);
@@ -56,13 +83,23 @@ void addLine(File *file, const char *content, int afterLine);
 
 void deleteLine(File *file, int lineNumber);
 
+Line *lineAt(File *file, int lineNumber);
+
+const char *peekLine(File *file, int lineNumber, int *length);
+
 void iterateLines(File *file, LineCallback callback);
 
 void iterateLinesInWindow(File *file, LineCallback callback);
 
+void iterateChangedLinesInWindow(File *file, LineCallback callback);
+
+void invalidateWindow(File *file);
+
 bool handleFileAction(File *file, int key);
 
-bool saveFile(File *file);
+bool findInFile(File *file, const char *pattern, int *lineNumber, int *column);
+
+int replaceInFile(File *file, const char *pattern, const char *replacement);
 
 void rerenderLine(Line *line, int index, bool errored, bool currentDebug);
 
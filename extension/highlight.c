@@ -15,20 +15,21 @@ static const char *mnemonics[] = {
         "b.gt", "b.le", "b.lt",
         "b.ne", "bic",  "bics",
         "br",   "cmn",  "cmp",
-        "eon",  "eor",  "ldr",
-        "madd", "mneg", "mov",
-        "movk", "movn", "movz",
-        "msub", "mul",  "mvn",
-        "neg",  "negs", "orn",
-        "orr",  "str",  "sub",
-        "subs", "tst"
+        "eon",  "eor",  "hlt",
+        "ldr",  "madd", "mneg",
+        "mov",  "movk", "movn",
+        "movz", "mrs",  "msub",
+        "mul",  "mvn",  "neg",
+        "negs", "orn",  "orr",
+        "str",  "sub",  "subs",
+        "tst"
 };
 
 /// Compare pointers to strings by the strings to which they point.
 /// @param s1 The pointer to the first string.
 /// @param s2 The pointer to the second string.
 /// @return The comparison of the strings pointed to by s1 and s2.
-static int strPtrCmp(char **ptr1, char **ptr2) {
+static int strPtrCmp(const char **ptr1, const char **ptr2) {
     return strcmp(*ptr1, *ptr2);
 }
 
@@ -45,19 +46,43 @@ void initialiseHighlight(void) {
     init_pair(H_REGISTER, COLOR_DARK_YELLOW, COLOR_TRUE_BLACK);
 }
 
-/// Print a line with syntax-highlighting at the current cursor position.
-/// @param window The window in which to print the line.
-/// @param string The string to syntax-highlight and print.
-void wPrintLine(WINDOW *window, char *string) {
+/// Append a run of characters to [highlight], merging it into the last run if they share a [HighlightType].
+/// @param highlight The [LineHighlight] to append to.
+/// @param start The index of the first character of the run.
+/// @param end The index just past the last character of the run.
+/// @param type The highlighting of the run.
+static void addSpan(LineHighlight *highlight, int start, int end, HighlightType type) {
+    if (start == end) return;
+
+    if (highlight->count > 0) {
+        HighlightSpan *last = &highlight->spans[highlight->count - 1];
+        if (last->type == type && last->start + last->length == start) {
+            last->length += end - start;
+            return;
+        }
+    }
+
+    if (highlight->count == highlight->capacity) {
+        highlight->capacity = highlight->capacity ? highlight->capacity * 2 : INITIAL_SPAN_COUNT;
+        highlight->spans = realloc(highlight->spans, highlight->capacity * sizeof(HighlightSpan));
+        assert(highlight->spans != NULL);
+    }
+
+    highlight->spans[highlight->count++] = (HighlightSpan) { start, end - start, type };
+}
+
+/// Split a line into runs of syntax-highlighting, replacing those in [highlight].
+/// @param string The string to syntax-highlight.
+/// @param highlight The [LineHighlight] to fill.
+static void highlightLine(const char *string, LineHighlight *highlight) {
+    highlight->count = 0;
 
     // The index of the last char of the line which has been printed.
     int printedIndex = 0;
 
     // Skip whitespace.
-    while (isspace(string[printedIndex])) {
-        waddch(window, string[printedIndex]);
-        printedIndex++;
-    }
+    while (isspace(string[printedIndex])) printedIndex++;
+    addSpan(highlight, 0, printedIndex, H_NONE);
 
     // Whether it's the first token on the line.
     bool firstToken = true;
@@ -173,12 +198,12 @@ void wPrintLine(WINDOW *window, char *string) {
             }
 
             int tokenLength = scannedIndex - printedIndex;
-            char *tokenPtr = &string[printedIndex];
+            const char *tokenPtr = &string[printedIndex];
 
-            // Make a copy of the token for searching in the list of mnemonics.
-            char *tokenCopy = malloc(sizeof(char) * (tokenLength+1));
-            strncpy(tokenCopy, tokenPtr, tokenLength);
-            tokenCopy[tokenLength] = '\0';
+            // Make a copy of the token for searching in the list of mnemonics, which are at most 4 chars.
+            char tokenCopy[5] = { 0 };
+            const char *tokenKey = tokenCopy;
+            if (tokenLength <= 4) memcpy(tokenCopy, tokenPtr, tokenLength);
 
             if (
                 // Token is at most 4 chars.
@@ -187,7 +212,7 @@ void wPrintLine(WINDOW *window, char *string) {
                 firstToken &&
                 // The token is in the list of mnemonics.
                 bsearch(
-                    &tokenCopy,
+                    &tokenKey,
                     mnemonics,
                     sizeof(mnemonics) / sizeof(char *),
                     sizeof(char *),
@@ -265,18 +290,12 @@ void wPrintLine(WINDOW *window, char *string) {
             ) {
                 highlightType = H_REGISTER;
             }
-
-            free(tokenCopy);
         }
 
 
-        // Print the token.
-        wattron(window, COLOR_PAIR(highlightType));
-        while (printedIndex < scannedIndex) {
-            waddch(window, string[printedIndex]);
-            printedIndex++;
-        }
-        wattroff(window, COLOR_PAIR(highlightType));
+        // Record the token.
+        addSpan(highlight, printedIndex, scannedIndex, highlightType);
+        printedIndex = scannedIndex;
 
         // Skip space, comma, or square bracket.
         while (
@@ -285,10 +304,28 @@ void wPrintLine(WINDOW *window, char *string) {
             string[printedIndex] == '[' ||
             string[printedIndex] == ']'
         ) {
-            waddch(window, string[printedIndex]);
             printedIndex++;
         }
+        addSpan(highlight, scannedIndex, printedIndex, H_NONE);
 
         firstToken = false;
     }
+
+    highlight->stale = false;
+}
+
+/// Print a line with syntax-highlighting at the current cursor position.
+/// The line is only scanned again if it has changed since it was last printed.
+/// @param window The window in which to print the line.
+/// @param string The string to syntax-highlight and print.
+/// @param highlight The cached [LineHighlight] of [string].
+void wPrintLine(WINDOW *window, const char *string, LineHighlight *highlight) {
+    if (highlight->stale) highlightLine(string, highlight);
+
+    for (int i = 0; i < highlight->count; i++) {
+        HighlightSpan span = highlight->spans[i];
+        wattron(window, COLOR_PAIR(span.type));
+        waddnstr(window, &string[span.start], span.length);
+        wattroff(window, COLOR_PAIR(span.type));
+    }
 }
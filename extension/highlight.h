@@ -8,6 +8,7 @@
 #ifndef HIGHLIGHT_H
 #define HIGHLIGHT_H
 
+#include <assert.h>
 #include <ncurses.h>
 #include <string.h>
 #include <stdlib.h>
@@ -21,6 +22,8 @@
 #define COLOR_ORANGE 202
 #define COLOR_DARK_YELLOW 220
 
+#define INITIAL_SPAN_COUNT 8
+
 /// The numeric code for the highlighting colour pair.
 typedef enum {
     /// No syntax highlighting.
@@ -52,8 +55,35 @@ typedef enum {
     H_REGISTER
 } HighlightType;
 
+/// A run of characters of a line which share a [HighlightType].
+typedef struct {
+    /// The index of the first character of the run.
+    int start;
+
+    /// The number of characters in the run.
+    int length;
+
+    /// The highlighting of the run.
+    HighlightType type;
+} HighlightSpan;
+
+/// The cached syntax-highlighting of a line, so that redraws need not scan it again.
+typedef struct {
+    /// The runs of the line, in order, covering all of its characters.
+    HighlightSpan *spans;
+
+    /// The number of runs in [spans].
+    int count;
+
+    /// The total capacity of [spans].
+    int capacity;
+
+    /// Whether the line has changed since [spans] were computed.
+    bool stale;
+} LineHighlight;
+
 
 void initialiseHighlight(void);
-void wPrintLine(WINDOW *window, char *string);
+void wPrintLine(WINDOW *window, const char *string, LineHighlight *highlight);
 
 #endif //HIGHLIGHT_H
@@ -11,10 +11,17 @@
 /// @param content If not [NULL], initialise this [Line] with [content].
 /// @returns A pointer to a new empty [Line].
 Line *initialiseLine(const char *content) {
+    return initialiseLineFrom(content, content ? strlen(content) : 0);
+}
+
+/// Initialise a [Line] with the first [contentLength] characters of [content], which need not be null-terminated.
+/// @param content The text of the [Line].
+/// @param contentLength The number of characters in the text.
+/// @returns A pointer to a new [Line].
+Line *initialiseLineFrom(const char *content, int contentLength) {
     Line *line = (Line *) malloc(sizeof(Line));
     assert(line != NULL);
 
-    int contentLength = content ? strlen(content) : 0;
     int bufferSize = (contentLength > INITIAL_LINE_SIZE) ? contentLength * 2 : INITIAL_LINE_SIZE;
 
     line->buffer = (char *) malloc(bufferSize);
@@ -28,6 +35,16 @@ Line *initialiseLine(const char *content) {
         memcpy(line->buffer, content, contentLength);
     }
 
+    // A new line has never been assembled.
+    line->edited = true;
+    line->assembly = (LineAssembly) {
+        .parseError = NULL, .label = NO_SYMBOL, .hasIR = false, .reference = NO_SYMBOL,
+        .translation = { .lineStatus = NONE }
+    };
+    line->highlight = (LineHighlight) { .spans = NULL, .count = 0, .capacity = 0, .stale = true };
+    line->breakpoint = (Breakpoint) { .enabled = false };
+    line->drawnRow = NOT_DRAWN;
+
     return line;
 }
 
@@ -35,6 +52,9 @@ Line *initialiseLine(const char *content) {
 /// @param line A pointer to the [Line] to free.
 void freeLine(Line *line) {
     if (!line) return;
+    free(line->assembly.parseError);
+    if (line->assembly.translation.lineStatus == ERRORED) free(line->assembly.translation.data.error);
+    free(line->highlight.spans);
     free(line->buffer);
     free(line);
 }
@@ -87,6 +107,9 @@ void insertCharAt(Line *line, char toInsert, int index) {
 
     moveGap(line, index);
     line->buffer[line->gapStart++] = toInsert;
+    line->edited = true;
+    line->highlight.stale = true;
+    line->drawnRow = NOT_DRAWN;
 }
 
 /// Remove a [char] from a [Line]'s contents at a given index.
@@ -98,6 +121,9 @@ void removeCharAt(Line *line, int index) {
 
     moveGap(line, index);
     line->gapEnd++;
+    line->edited = true;
+    line->highlight.stale = true;
+    line->drawnRow = NOT_DRAWN;
 }
 
 /// Insert a string into a [Line]'s contents at a given index.
@@ -116,6 +142,9 @@ void insertStrAt(Line *line, const char *toInsert, int index) {
     moveGap(line, index);
     memcpy(line->buffer + line->gapStart, toInsert, insertLength);
     line->gapStart += insertLength;
+    line->edited = true;
+    line->highlight.stale = true;
+    line->drawnRow = NOT_DRAWN;
 }
 
 /// Remove a substring from a [Line]'s contents between [start] and [end].
@@ -128,6 +157,9 @@ void removeStrAt(Line *line, int start, int end) {
 
     moveGap(line, start);
     line->gapEnd += (end - start);
+    line->edited = true;
+    line->highlight.stale = true;
+    line->drawnRow = NOT_DRAWN;
 }
 
 /// Calculates the length of the given [Line].
@@ -151,3 +183,17 @@ char *getLine(Line *line) {
 
     return result;
 }
+
+/// Views a [Line]'s contents in place, by moving the gap to the end of the buffer.
+/// @param line The [Line] to view.
+/// @returns The text represented by the [Line], valid until it is next modified.
+const char *viewLine(Line *line) {
+    // Leave room in the gap for the null terminator.
+    if (line->gapStart == line->gapEnd) {
+        resizeLine(line, line->size * 2);
+    }
+
+    moveGap(line, lineLength(line));
+    line->buffer[line->gapStart] = '\0';
+    return line->buffer;
+}
@@ -9,12 +9,57 @@
 #define EXTENSION_LINE_H
 
 #include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
+#include "breakpoint.h"
+#include "const.h"
+#include "highlight.h"
+#include "ir.h"
+
 #define INITIAL_LINE_SIZE 8
 
+/// The row standing for a [Line] which must be drawn again, wherever it is.
+#define NOT_DRAWN -1
+
+/// The symbol ID standing for no label in a [LineAssembly].
+#define NO_SYMBOL SIZE_MAX
+
+/// Binary mode's cached assembly of a line, so that only edited lines are parsed again.
+typedef struct {
+
+    /// The error from parsing the line, or NULL if it parsed.
+    char *parseError;
+
+    /// The symbol ID of the label the line defines, or [NO_SYMBOL] if none.
+    size_t label;
+
+    /// Whether [label] was already defined by an earlier line.
+    bool duplicate;
+
+    /// Whether the line parsed into an instruction or directive.
+    bool hasIR;
+
+    /// The parsed instruction. It is translated from a copy, as translation resolves labels in place.
+    IR ir;
+
+    /// The symbol ID of the label [ir] references, or [NO_SYMBOL] if none.
+    size_t reference;
+
+    /// The address of the instruction.
+    BitData address;
+
+    /// Whether [translation] must be redone, as the line was parsed again or its instruction moved.
+    bool stale;
+
+    /// The result of translating [ir]: [ASSEMBLED] with the instruction, or [ERRORED] with an owned error.
+    LineInfo translation;
+
+} LineAssembly;
+
 /// Implementation of a gap buffer, representing a line of text.
 typedef struct {
     /// The buffer contents.
@@ -28,10 +73,27 @@ typedef struct {
 
     /// The end of the gap, zero-indexed.
     int gapEnd;
+
+    /// Whether the contents have changed since [assembly] was last brought up to date.
+    bool edited;
+
+    /// The cached assembly of the line, for binary mode.
+    LineAssembly assembly;
+
+    /// The cached syntax-highlighting of the line, marked stale on every edit.
+    LineHighlight highlight;
+
+    /// The breakpoint on the line, for debug mode.
+    Breakpoint breakpoint;
+
+    /// The row of the window at which the line was last drawn, or [NOT_DRAWN] if it has changed since.
+    int drawnRow;
 } Line;
 
 Line *initialiseLine(const char *content);
 
+Line *initialiseLineFrom(const char *content, int contentLength);
+
 void freeLine(Line *line);
 
 void insertCharAt(Line *line, char toInsert, int index);
@@ -46,6 +108,8 @@ int lineLength(Line *line);
 
 char *getLine(Line *line);
 
+const char *viewLine(Line *line);
+
 void updateLine(Line *line, int index);
 
 #endif //EXTENSION_LINE_H
@@ -0,0 +1,79 @@
+///
+/// promptOverlay.c
+/// The destructive overlay displayed when the user is asked for a line of input, such as a breakpoint condition.
+///
+
+#include "promptOverlay.h"
+
+static const char *promptFormat = "[ %s: %s ]";
+
+/// Prompts for a line of input until [handler] accepts it or the prompt is cancelled.
+/// @param label The label of the prompt.
+/// @param usage The text displayed when [handler] rejects the input.
+/// @param initial The initial input.
+/// @param handler The [PromptHandler] to accept the input.
+/// @param context The context passed to [handler].
+/// @returns Whether [handler] accepted some input, rather than the prompt being cancelled.
+bool showPromptOverlay(const char *label, const char *usage, const char *initial, PromptHandler handler, void *context) {
+    // Create a window for the overlay with dimensions covering the entire screen
+    WINDOW *promptOverlay = newwin(0, 0, 0, 0);
+    wbkgd(promptOverlay, COLOR_PAIR(MENU_SCHEME));
+    keypad(promptOverlay, TRUE);
+
+    char input[MAX_PROMPT_LENGTH] = "";
+    snprintf(input, sizeof(input), "%s", initial);
+    int length = strlen(input);
+    int promptLength = strlen(label) + 6;
+    int usageLength = strlen(usage);
+
+    mvwprintw(promptOverlay, rows / 2, (cols - promptLength - length) / 2, promptFormat, label, input);
+    wmove(promptOverlay, rows / 2, (cols + promptLength + length) / 2 - 2);
+    wrefresh(promptOverlay);
+
+    // Process user input
+    int key;
+    while ((key = wgetch(promptOverlay)) != KEY_F(1)) {
+        switch (key) {
+            case KEY_BACKSPACE:
+            case 127:
+                if (length > 0) input[--length] = '\0';
+                break;
+
+            case KEY_ENTER:
+            case 10:
+                if (handler(input, context)) {
+                    delwin(promptOverlay);
+                    endwin();
+                    return true;
+                }
+
+                mvwaddstr(promptOverlay, rows / 2 + 2, (cols - usageLength) / 2, usage);
+                break;
+
+            case 27: // ESC key
+                delwin(promptOverlay);
+                endwin();
+                return false;
+
+            default:
+                if (isprint(key) && length + 1 < MAX_PROMPT_LENGTH) {
+                    input[length++] = key;
+                    input[length] = '\0';
+                }
+                break;
+        }
+
+        // Clear the line and render the updated input
+        wmove(promptOverlay, rows / 2, 0);
+        wclrtoeol(promptOverlay);
+        mvwprintw(promptOverlay, rows / 2, (cols - promptLength - length) / 2, promptFormat, label, input);
+        wmove(promptOverlay, rows / 2, (cols + promptLength + length) / 2 - 2);
+        wrefresh(promptOverlay);
+    }
+
+    // Clean up
+    delwin(promptOverlay);
+    endwin();
+
+    return false;
+}
@@ -0,0 +1,29 @@
+///
+/// promptOverlay.h
+/// The destructive overlay displayed when the user is asked for a line of input, such as a breakpoint condition.
+///
+
+#ifndef EXTENSION_PROMPT_OVERLAY_H
+#define EXTENSION_PROMPT_OVERLAY_H
+
+#include <ctype.h>
+#include <ncurses.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "const.h"
+
+/// The maximum length of the input to a prompt.
+#define MAX_PROMPT_LENGTH 64
+
+/// Accepts the input to a prompt, e.g., by parsing it into [context].
+/// @param input The input.
+/// @param context The context passed to [showPromptOverlay].
+/// @returns Whether the input was valid, which closes the prompt.
+typedef bool (*PromptHandler)(const char *input, void *context);
+
+extern int rows, cols;
+
+bool showPromptOverlay(const char *label, const char *usage, const char *initial, PromptHandler handler, void *context);
+
+#endif // EXTENSION_PROMPT_OVERLAY_H
@@ -17,6 +17,7 @@
 #include "const.h"
 #include "helpers.h"
 #include "file.h"
+#include "saver.h"
 
 extern int rows, cols;
 
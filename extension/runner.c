@@ -0,0 +1,77 @@
+///
+/// runner.c
+/// Runs an assembled program on a worker thread, so that the editor stays responsive.
+///
+
+#include "runner.h"
+
+/// Runs the program of a [Run] until it halts, errors, reaches a breakpoint or watchpoint, or is asked to stop.
+/// Fatal errors jump back here, as [fatalBuffer] is only set on this thread while it runs, and the count of
+/// instructions executed is kept [volatile] so that it is still published after such a jump.
+/// @param arg The [Run] to execute.
+/// @returns [NULL].
+static void *runWorker(void *arg) {
+    Run *run = (Run *) arg;
+
+    run->errored = false;
+    run->watched = false;
+    volatile uint64_t executed = 0;
+    if (!setjmp(fatalBuffer)) {
+        Instruction instruction = readMem(run->memory, false, getRegPC(&run->registers));
+
+        // Fetch, decode, execute cycle while the program has not terminated.
+        while (instruction != HALT && !atomic_load_explicit(&run->stop, memory_order_relaxed)) {
+            execute(&instruction, &run->registers, run->memory);
+            if (++executed % RUN_PUBLISH_INTERVAL == 0) {
+                atomic_store_explicit(&run->executed, executed, memory_order_relaxed);
+            }
+
+            if (run->breakpoints != NULL && breakpointHit(run->breakpoints, &run->registers)) break;
+            if (takeWatchpointHit(&run->watchpointHit)) {
+                run->watched = true;
+                break;
+            }
+        }
+    } else {
+        run->errored = true;
+    }
+    atomic_store_explicit(&run->executed, executed, memory_order_relaxed);
+
+    run->seconds = secondsSince(&run->start);
+    atomic_store(&run->finished, true);
+    return NULL;
+}
+
+/// Starts running the program in [memory] from [registers] on a worker thread.
+/// At least one instruction is executed before any breakpoint is checked, so a run may continue from one.
+/// @param run The [Run] to start.
+/// @param registers The state of the registers to start from.
+/// @param memory The memory holding the program, which the worker owns until [stopRun] returns.
+/// @param breakpoints The breakpoints at which to stop, or [NULL] to run until the program halts.
+void startRun(Run *run, Registers_s registers, Memory memory, const BreakpointMap *breakpoints) {
+    run->registers = registers;
+    run->memory = memory;
+    run->breakpoints = breakpoints;
+    atomic_init(&run->executed, 0);
+    atomic_init(&run->stop, false);
+    atomic_init(&run->finished, false);
+    clock_gettime(CLOCK_MONOTONIC, &run->start);
+
+    assertFatal(pthread_create(&run->thread, NULL, runWorker, run) == 0, "Could not start the run thread!");
+}
+
+/// Stops a [Run], if it has not finished already, and waits for its worker to exit.
+/// @param run The [Run] to stop.
+void stopRun(Run *run) {
+    atomic_store(&run->stop, true);
+    pthread_join(run->thread, NULL);
+}
+
+/// Measures the time elapsed since [start].
+/// @param start The monotonic time to measure from.
+/// @returns The number of seconds since [start].
+double secondsSince(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
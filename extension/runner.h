@@ -0,0 +1,71 @@
+///
+/// runner.h
+/// Runs an assembled program on a worker thread, so that the editor stays responsive.
+///
+
+#ifndef EXTENSION_RUNNER_H
+#define EXTENSION_RUNNER_H
+
+#include <pthread.h>
+#include <setjmp.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "breakpoint.h"
+#include "emulatorDelegate.h"
+#include "error.h"
+#include "memory.h"
+#include "registers.h"
+#include "watchpoint.h"
+
+/// The number of instructions between each publication of [Run.executed].
+#define RUN_PUBLISH_INTERVAL 4096
+
+/// A program running on a worker thread.
+typedef struct {
+    /// The registers of the program, owned by the worker until [stopRun] returns.
+    Registers_s registers;
+
+    /// The memory of the program, owned by the worker until [stopRun] returns.
+    Memory memory;
+
+    /// The breakpoints at which to stop, or [NULL] to run until the program halts.
+    const BreakpointMap *breakpoints;
+
+    /// The number of instructions executed so far, published every [RUN_PUBLISH_INTERVAL].
+    _Atomic uint64_t executed;
+
+    /// Set to ask the worker to stop before the next instruction.
+    atomic_bool stop;
+
+    /// Set by the worker once the program has halted, errored, or stopped.
+    atomic_bool finished;
+
+    /// Whether the program stopped on a fatal error, set once it has [finished].
+    bool errored;
+
+    /// Whether the program stopped on a write to a watched range, set once it has [finished].
+    bool watched;
+
+    /// The write which stopped the program, if [watched].
+    WatchpointHit watchpointHit;
+
+    /// The monotonic time at which the run started.
+    struct timespec start;
+
+    /// The number of seconds the worker spent running, set once it has [finished].
+    double seconds;
+
+    /// The worker thread.
+    pthread_t thread;
+} Run;
+
+void startRun(Run *run, Registers_s registers, Memory memory, const BreakpointMap *breakpoints);
+
+void stopRun(Run *run);
+
+double secondsSince(const struct timespec *start);
+
+#endif // EXTENSION_RUNNER_H
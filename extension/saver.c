@@ -0,0 +1,144 @@
+///
+/// saver.c
+/// Saves a snapshot of a [File] on a worker thread, so that the editor stays responsive.
+///
+
+#include "saver.h"
+
+/// Appends a run of text to the snapshot of a [Save], extending the last segment if the text follows on from it.
+/// @param save The [Save] to modify.
+/// @param copied Whether the text is in [Save.copied], rather than [File.original].
+/// @param start The offset of the text in its source.
+/// @param length The number of characters of text.
+static void addSegment(Save *save, bool copied, size_t start, size_t length) {
+    if (save->segmentCount > 0) {
+        SaveSegment *last = &save->segments[save->segmentCount - 1];
+        if (last->copied == copied && last->start + last->length == start) {
+            last->length += length;
+            return;
+        }
+    }
+
+    if (save->segmentCount == save->segmentCapacity) {
+        save->segmentCapacity = save->segmentCapacity ? save->segmentCapacity * 2 : INITIAL_FILE_SIZE;
+        save->segments = realloc(save->segments, save->segmentCapacity * sizeof(SaveSegment));
+        assert(save->segments != NULL);
+    }
+    save->segments[save->segmentCount++] = (SaveSegment) { copied, start, length };
+}
+
+/// Copies some text, followed by a newline, into the snapshot of a [Save].
+/// @param save The [Save] to modify.
+/// @param text The text to copy, which need not be null-terminated.
+/// @param length The number of characters of text.
+static void copyText(Save *save, const char *text, size_t length) {
+    if (save->copiedLength + length + 1 > save->copiedCapacity) {
+        size_t needed = save->copiedLength + length + 1;
+        save->copiedCapacity = (needed > save->copiedCapacity * 2) ? needed : save->copiedCapacity * 2;
+        save->copied = realloc(save->copied, save->copiedCapacity);
+        assert(save->copied != NULL);
+    }
+
+    memcpy(save->copied + save->copiedLength, text, length);
+    save->copied[save->copiedLength + length] = '\n';
+    addSegment(save, true, save->copiedLength, length + 1);
+    save->copiedLength += length + 1;
+}
+
+/// Writes the snapshot of a [Save] to a temporary file, then renames it over the path. The path therefore always
+/// holds either the old text or the whole of the new text, even if GRIM or the computer stops mid-write.
+/// @param arg The [Save] to write.
+/// @returns [NULL].
+static void *saveWorker(void *arg) {
+    Save *save = (Save *) arg;
+    save->saved = false;
+
+    char *temporary;
+    asprintf(&temporary, "%s.XXXXXX", save->path);
+    int descriptor = mkstemp(temporary);
+    if (descriptor == -1) {
+        free(temporary);
+        atomic_store(&save->finished, true);
+        return NULL;
+    }
+
+    // Keep the permissions of the file being replaced, or give a new file the usual ones.
+    struct stat info;
+    mode_t mask = umask(0);
+    umask(mask);
+    fchmod(descriptor, (stat(save->path, &info) == 0) ? info.st_mode & 07777 : 0666 & ~mask);
+
+    FILE *f = fdopen(descriptor, "w");
+    if (f == NULL) {
+        close(descriptor);
+    } else {
+        for (size_t i = 0; i < save->segmentCount; i++) {
+            const SaveSegment *segment = &save->segments[i];
+            fwrite((segment->copied ? save->copied : save->original) + segment->start, 1, segment->length, f);
+        }
+
+        // The text must be on disk before the rename makes it the file.
+        bool written = fflush(f) == 0 && !ferror(f) && fsync(descriptor) == 0;
+        written &= fclose(f) == 0;
+        save->saved = written && rename(temporary, save->path) == 0;
+    }
+    if (!save->saved) unlink(temporary);
+
+    free(temporary);
+    atomic_store(&save->finished, true);
+    return NULL;
+}
+
+/// Takes a snapshot of [file] and starts writing it to its path on a worker thread.
+/// @param save The [Save] to start.
+/// @param file The [File] to save, whose original contents must stay mapped until [finishSave] returns.
+/// @pre [file] has a path.
+void startSave(Save *save, File *file) {
+    *save = (Save) { .path = strdup(file->path), .original = file->original };
+    atomic_init(&save->finished, false);
+
+    // Lines which have been read in are copied, but lines still in the original are only referred to.
+    for (int i = 0; i < file->indexed; i++) {
+        int length;
+        const char *text = peekLine(file, i, &length);
+        if (file->lines[i] != NULL) {
+            copyText(save, text, length);
+        } else if (text + length != file->original + file->originalLength) {
+            addSegment(save, false, text - file->original, length + 1);
+        } else {
+            copyText(save, text, length);
+        }
+    }
+    if (file->indexed < file->size) {
+        // The lines which have not been indexed are the rest of the original, in order.
+        size_t length = file->originalLength - file->scanOffset;
+        if (file->original[file->originalLength - 1] == '\n') {
+            addSegment(save, false, file->scanOffset, length);
+        } else {
+            copyText(save, file->original + file->scanOffset, length);
+        }
+    }
+
+    assertFatal(pthread_create(&save->thread, NULL, saveWorker, save) == 0, "Could not start the save thread!");
+}
+
+/// Waits for the worker of a [Save] to finish, and frees its snapshot.
+/// @param save The [Save] to finish.
+/// @returns Whether the snapshot replaced the file at its path.
+bool finishSave(Save *save) {
+    pthread_join(save->thread, NULL);
+
+    free(save->path);
+    free(save->copied);
+    free(save->segments);
+    return save->saved;
+}
+
+/// Saves [file] to its path, waiting for the write to finish.
+/// @param file The [File] to save.
+/// @returns Whether the file was saved.
+bool saveFile(File *file) {
+    Save save;
+    startSave(&save, file);
+    return finishSave(&save);
+}
@@ -0,0 +1,71 @@
+///
+/// saver.h
+/// Saves a snapshot of a [File] on a worker thread, so that the editor stays responsive.
+///
+
+#ifndef EXTENSION_SAVER_H
+#define EXTENSION_SAVER_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "error.h"
+#include "file.h"
+
+/// A run of text to be written, from either the original contents of a [File] or the copied text of a [Save].
+typedef struct {
+    /// Whether the text is in [Save.copied], rather than [File.original].
+    bool copied;
+
+    /// The offset of the text in its source.
+    size_t start;
+
+    /// The number of characters of text.
+    size_t length;
+} SaveSegment;
+
+/// A snapshot of a [File] being written to its path on a worker thread.
+/// Lines still only in the original contents are written straight from its mapping, so only the lines which have
+/// been read in are copied when the snapshot is taken.
+typedef struct {
+    /// The path to write to, owned by the [Save].
+    char *path;
+
+    /// The original contents of the [File], which must stay mapped until [finishSave] returns.
+    const char *original;
+
+    /// The text of the lines which had been read in, each followed by a newline.
+    char *copied;
+
+    /// The number of characters in [copied], and its capacity.
+    size_t copiedLength, copiedCapacity;
+
+    /// The text of the snapshot, in order.
+    SaveSegment *segments;
+
+    /// The number of [segments], and their capacity.
+    size_t segmentCount, segmentCapacity;
+
+    /// Set by the worker once the snapshot has been written, or has failed to be.
+    atomic_bool finished;
+
+    /// Whether the snapshot replaced the file at [path], set once it has [finished].
+    bool saved;
+
+    /// The worker thread.
+    pthread_t thread;
+} Save;
+
+void startSave(Save *save, File *file);
+
+bool finishSave(Save *save);
+
+bool saveFile(File *file);
+
+#endif // EXTENSION_SAVER_H
@@ -12,113 +12,340 @@ static void updateBinaryLine(unused Line *line, int index);
 
 static void strBinRep(char *str, Instruction instruction);
 
-/// Updates the binary side panel with the current binary representations of the assembly code.
-void updateBinary(void) {
-    // Allocate memory for the lineInfo array.
-    lineInfo = malloc(file->size * sizeof(LineInfo));
+/// The assembler state shared by all updates, in which labels keep their symbol IDs between keystrokes.
+static AssemblerState state;
+
+/// Whether [state] has been created.
+static bool stateCreated = false;
+
+/// The address of each symbol before the latest update, indexed by symbol ID.
+static BitData *previousAddresses = NULL;
+
+/// Whether each symbol was defined before the latest update, indexed by symbol ID.
+static bool *previouslyDefined = NULL;
+
+/// Whether each symbol moved, or became defined or undefined, in the latest update, indexed by symbol ID.
+static bool *moved = NULL;
+
+/// The number of symbols that the arrays above are allocated for.
+static size_t symbolCapacity = 0;
+
+/// Binary mode's cached assembly of a line still only in the file's mapping. Such lines are never drawn, as the lines
+/// in the window are always read in, so only what lays out the labels and instructions is kept.
+typedef struct {
+    /// The offset in [File.original] at which the line starts.
+    size_t offset;
+
+    /// The symbol ID of the label the line defines, or [NO_SYMBOL] if none.
+    size_t label;
+
+    /// Whether the line parsed into an instruction or directive.
+    bool hasIR;
+} MappedAssembly;
+
+/// The cached assemblies of the lines parsed while still only in the mapping, in order of [MappedAssembly.offset].
+static MappedAssembly *mappedAssemblies = NULL;
+
+/// The number of entries in [mappedAssemblies].
+static size_t mappedCount = 0;
+
+/// The total capacity of [mappedAssemblies].
+static size_t mappedCapacity = 0;
+
+/// The entry of [mappedAssemblies] at which [mappedAssemblyAt] carries on looking.
+static size_t mappedCursor = 0;
+
+/// Parses [length] characters of [text] on their own into [assembly], interning any labels in [state].
+/// @param text The text of the line, which need not be null-terminated.
+/// @param length The number of characters in [text].
+/// @param assembly The [LineAssembly] to overwrite.
+static void parseBinaryText(const char *text, int length, LineAssembly *assembly) {
+    free(assembly->parseError);
+    assembly->parseError = NULL;
+    assembly->label = NO_SYMBOL;
+    assembly->hasIR = false;
+    assembly->reference = NO_SYMBOL;
+    assembly->stale = true;
+
+    fatalError[0] = '\0';
+
+    if (!setjmp(fatalBuffer)) {
+        TokenisedLine tokenisedLine;
+        tokenise(text, text + length, &tokenisedLine);
+
+        // The label stays defined even if the instruction after it fails to parse.
+        if (tokenisedLine.label != NULL) {
+            assembly->label = internLabel(&state, tokenisedLine.label, tokenisedLine.labelLength);
+        }
 
-    AssemblerState state = createState();
+        if (tokenisedLine.hasInstruction) {
+            assembly->ir = parseInstruction(&tokenisedLine, &state);
+            Literal *literal = getLabelLiteral(&assembly->ir);
+            assembly->reference = (literal != NULL) ? literal->data.label.id : NO_SYMBOL;
+            assembly->hasIR = true;
+        }
+    } else {
+        assembly->parseError = strdup(fatalError);
+    }
+}
+
+/// Parses [line] on its own into its cached [LineAssembly], interning any labels in [state].
+/// @param line The [Line] to parse.
+static void parseBinaryLine(Line *line) {
+    parseBinaryText(viewLine(line), lineLength(line), &line->assembly);
+}
 
-    // Perform the first pass of the assembler.
+/// Finds the cached assembly of a line which has not been read in, parsing it the first time it is needed.
+/// Such lines are always the original lines in order, so each pass over the file finds them by walking
+/// [mappedCursor] forwards, which must be reset before the pass.
+/// @param lineNumber The line number of the line, which must not have been read in.
+/// @returns The [MappedAssembly] of the line.
+static MappedAssembly *mappedAssemblyAt(int lineNumber) {
+    int length;
+    const char *text = peekLine(file, lineNumber, &length);
+    size_t offset = text - file->original;
+
+    while (mappedCursor < mappedCount && mappedAssemblies[mappedCursor].offset < offset) mappedCursor++;
+    if (mappedCursor < mappedCount && mappedAssemblies[mappedCursor].offset == offset) {
+        return &mappedAssemblies[mappedCursor];
+    }
+
+    LineAssembly assembly = { .parseError = NULL };
+    parseBinaryText(text, length, &assembly);
+    free(assembly.parseError);
+
+    if (mappedCount == mappedCapacity) {
+        mappedCapacity = mappedCapacity ? mappedCapacity * 2 : 1024; // Exponential scaling policy.
+        mappedAssemblies = realloc(mappedAssemblies, mappedCapacity * sizeof(MappedAssembly));
+        assert(mappedAssemblies != NULL);
+    }
+    memmove(&mappedAssemblies[mappedCursor + 1], &mappedAssemblies[mappedCursor],
+            (mappedCount++ - mappedCursor) * sizeof(MappedAssembly));
+    mappedAssemblies[mappedCursor] = (MappedAssembly) { offset, assembly.label, assembly.hasIR };
+    return &mappedAssemblies[mappedCursor];
+}
+
+/// Brings [symbolCapacity] up to the number of symbols in [state].
+static void growSymbolArrays(void) {
+    if (symbolCapacity >= state.symbolCount) return;
+
+    // Exponential (doubling) scaling policy.
+    while (symbolCapacity < state.symbolCount) symbolCapacity = symbolCapacity ? symbolCapacity * 2 : 64;
+    previousAddresses = realloc(previousAddresses, symbolCapacity * sizeof(BitData));
+    previouslyDefined = realloc(previouslyDefined, symbolCapacity * sizeof(bool));
+    moved = realloc(moved, symbolCapacity * sizeof(bool));
+    assert(previousAddresses != NULL && previouslyDefined != NULL && moved != NULL);
+}
+
+/// Rebuilds [state] with only the symbols which some line still defines or refers to. Each keystroke interns the
+/// labels of the line it edits, so every partial label typed along the way (e.g., <l>, <lo>, <loo>) would otherwise
+/// stay in [state] for the whole session. The rebuild only happens once such dead symbols outnumber the live ones,
+/// so its cost is spread over the edits which left them behind.
+static void compactSymbols(void) {
+    if (state.symbolCount < MIN_COMPACT_SYMBOLS) return;
+
+    // Mark the live symbols, then number them in order of their old IDs.
+    size_t *newIds = calloc(state.symbolCount, sizeof(size_t));
+    assert(newIds != NULL);
     for (int i = 0; i < file->size; i++) {
-        size_t irCount = state.irCount;
-
-        LineInfo currLineInfo;
-        fatalError[0] = '\0';
-
-        setjmp(fatalBuffer);
-        if (fatalError[0] != '\0') {
-            // An error has occured.
-            currLineInfo.lineStatus = ERRORED;
-            currLineInfo.data.error = strdup(fatalError);
-        } else {
-            parse(getLine(file->lines[i]), &state);
-
-            // At this point, the parsing was successful.
-            currLineInfo.lineStatus = (state.irCount == irCount) ? NONE : ASSEMBLED;
-            currLineInfo.data.error = NULL;
+        if (file->lines[i] == NULL) continue;
+        const LineAssembly *assembly = &file->lines[i]->assembly;
+        if (assembly->label != NO_SYMBOL) newIds[assembly->label] = 1;
+        if (assembly->reference != NO_SYMBOL) newIds[assembly->reference] = 1;
+    }
+    for (size_t i = 0; i < mappedCount; i++) {
+        if (mappedAssemblies[i].label != NO_SYMBOL) newIds[mappedAssemblies[i].label] = 1;
+    }
+
+    size_t live = 0;
+    for (size_t id = 0; id < state.symbolCount; id++) {
+        newIds[id] = newIds[id] ? live++ : NO_SYMBOL;
+    }
+    if (state.symbolCount - live <= live) {
+        free(newIds);
+        return;
+    }
+
+    AssemblerState compacted = createState();
+    for (size_t id = 0; id < state.symbolCount; id++) {
+        if (newIds[id] == NO_SYMBOL) continue;
+        const struct Symbol *symbol = &state.symbolTable[id];
+        size_t newId = internLabel(&compacted, symbol->label, symbol->length);
+        compacted.symbolTable[newId].address = symbol->address;
+        compacted.symbolTable[newId].defined = symbol->defined;
+    }
+
+    // Re-point every line at the new IDs, including the label names held by the cached IRs.
+    for (int i = 0; i < file->size; i++) {
+        if (file->lines[i] == NULL) continue;
+        LineAssembly *assembly = &file->lines[i]->assembly;
+        if (assembly->label != NO_SYMBOL) assembly->label = newIds[assembly->label];
+        if (assembly->reference != NO_SYMBOL) {
+            size_t id = assembly->reference = newIds[assembly->reference];
+            getLabelLiteral(&assembly->ir)->data.label = (struct Label) {
+                .id = id, .name = compacted.symbolTable[id].label
+            };
         }
+    }
 
-        lineInfo[i] = currLineInfo;
+    for (size_t i = 0; i < mappedCount; i++) {
+        if (mappedAssemblies[i].label != NO_SYMBOL) mappedAssemblies[i].label = newIds[mappedAssemblies[i].label];
     }
 
-    // Keep track of which line we're doing a second pass on, and reset counter.
-    int currLineNum = 0;
-    state.address = 0x0;
+    free(newIds);
+    destroyState(state);
+    state = compacted;
+}
 
-    // Perform the second pass of the assembler.
-    for (size_t i = 0; i < state.irCount; i++) {
-        // Skip lines which do not require a second pass.
-        while (lineInfo[currLineNum].lineStatus != ASSEMBLED) currLineNum++;
+/// Translates the cached instruction of [line] at its address, caching the result.
+/// @param line The [Line] to translate.
+static void translateBinaryLine(Line *line) {
+    LineAssembly *assembly = &line->assembly;
+    if (assembly->translation.lineStatus == ERRORED) free(assembly->translation.data.error);
+    assembly->stale = false;
 
-        IR ir = state.irList[i];
-        fatalError[0] = '\0';
+    // Translation resolves labels in place, so keep the parsed IR intact for next time.
+    IR ir = assembly->ir;
+    state.address = assembly->address;
+    fatalError[0] = '\0';
 
-        setjmp(fatalBuffer);
-        if (fatalError[0] != '\0') {
-            // Fatal error was encountered during second assembly pass.
-            free(lineInfo[currLineNum].data.error);
-            lineInfo[currLineNum].lineStatus = ERRORED;
-            lineInfo[currLineNum].data.error = strdup(fatalError);
-        } else {
-            Instruction instruction = getTranslator(&ir.type)(&ir, &state);
+    if (!setjmp(fatalBuffer)) {
+        assembly->translation.data.instruction = getTranslator(&ir.type)(&ir, &state);
+        assembly->translation.lineStatus = ASSEMBLED;
+    } else {
+        assembly->translation.data.error = strdup(fatalError);
+        assembly->translation.lineStatus = ERRORED;
+    }
+}
+
+/// Updates the binary side panel with the current binary representations of the assembly code.
+/// Only lines edited since the last update are parsed again, and only instructions which were parsed again, moved,
+/// or reference a label which moved are translated again. Lines outside the window which have not been read in are
+/// parsed straight from the mapping, once, so binary mode does not read the whole file into [Line]s.
+void updateBinary(void) {
+    if (!stateCreated) {
+        state = createState();
+        stateCreated = true;
+    }
 
-            // If this code is reached, the line was assembled.
-            lineInfo[currLineNum].lineStatus = ASSEMBLED;
-            lineInfo[currLineNum].data.instruction = instruction;
+    // Read in the lines in the window, so that they are parsed and translated in time to be drawn.
+    for (int i = file->windowY; i < file->size && i < file->windowY + CONTENT_HEIGHT; i++) {
+        lineAt(file, i);
+    }
+
+    // Parse the edited lines, and any lines in the mapping not yet parsed.
+    mappedCursor = 0;
+    for (int i = 0; i < file->size; i++) {
+        Line *line = file->lines[i];
+        if (line == NULL) {
+            mappedAssemblyAt(i);
+        } else if (line->edited) {
+            parseBinaryLine(line);
+            line->edited = false;
         }
+    }
 
-        state.address += 0x4;
-        currLineNum++;
+    // Lay out the labels and instructions again, which is cheap as nothing is parsed.
+    compactSymbols();
+    growSymbolArrays();
+    for (size_t id = 0; id < state.symbolCount; id++) {
+        previousAddresses[id] = state.symbolTable[id].address;
+        previouslyDefined[id] = state.symbolTable[id].defined;
+        state.symbolTable[id].defined = false;
     }
 
-    // Print out all lines in current window.
-    iterateLinesInWindow(file, &updateBinaryLine);
+    BitData address = 0x0;
+    mappedCursor = 0;
+    for (int i = 0; i < file->size; i++) {
+        if (file->lines[i] == NULL) {
+            // Lines in the mapping are never drawn, so only their labels and addresses matter.
+            MappedAssembly *mapped = mappedAssemblyAt(i);
+            if (mapped->label != NO_SYMBOL && !state.symbolTable[mapped->label].defined) {
+                state.symbolTable[mapped->label].address = address;
+                state.symbolTable[mapped->label].defined = true;
+            }
+            if (mapped->hasIR) address += 0x4;
+            continue;
+        }
 
-    // Free the line info
-    destroyState(state);
+        LineAssembly *assembly = &file->lines[i]->assembly;
+
+        bool duplicate = false;
+        if (assembly->label != NO_SYMBOL) {
+            struct Symbol *symbol = &state.symbolTable[assembly->label];
+            duplicate = symbol->defined;
+            if (!symbol->defined) {
+                symbol->address = address;
+                symbol->defined = true;
+            }
+        }
+        if (assembly->duplicate != duplicate) file->lines[i]->drawnRow = NOT_DRAWN;
+        assembly->duplicate = duplicate;
+
+        if (assembly->hasIR) {
+            assembly->stale |= assembly->address != address;
+            assembly->address = address;
+            address += 0x4;
+        }
+    }
+
+    for (size_t id = 0; id < state.symbolCount; id++) {
+        struct Symbol *symbol = &state.symbolTable[id];
+        moved[id] = symbol->defined != previouslyDefined[id]
+                    || (symbol->defined && symbol->address != previousAddresses[id]);
+    }
+
+    // Translate the instructions whose encoding may have changed.
     for (int i = 0; i < file->size; i++) {
-        // Free all error strings
-        if (lineInfo[i].lineStatus == ERRORED) {
-            free(lineInfo[i].data.error);
+        Line *line = file->lines[i];
+        if (line == NULL) continue;
+
+        LineAssembly *assembly = &line->assembly;
+        if (assembly->hasIR && (assembly->stale || (assembly->reference != NO_SYMBOL && moved[assembly->reference]))) {
+            translateBinaryLine(line);
+            line->drawnRow = NOT_DRAWN;
         }
     }
-    free(lineInfo);
+
+    // Print out the lines in the current window which have changed.
+    iterateChangedLinesInWindow(file, &updateBinaryLine);
 }
 
 /// Updates the binary side panel with the current state of the binary representation of the assembly code.
 /// @param line The line to rerender.
 /// @param index The index of the line in the window.
-static void updateBinaryLine(unused Line *line, int index) {
-    bool lineErrored = false;
-
-    switch (lineInfo[index].lineStatus) {
-        case ERRORED:
-            // Display the error
-            wattron(side, COLOR_PAIR((index == file->lineNumber) ? I_ERROR_SCHEME : ERROR_SCHEME));
-            mvwaddnstr(side, index - file->windowY, 0,
-                        lineInfo[index].data.error, (cols - 1) / 2);
-            wattroff(side, COLOR_PAIR((index == file->lineNumber) ? I_ERROR_SCHEME : ERROR_SCHEME));
-
-            lineErrored = true;
-            break;
-
-        case ASSEMBLED: {
-            // Convert the instruction to a string.
-            char instrStr[8 * sizeof(Instruction) + 8];
-            strBinRep(instrStr, lineInfo[index].data.instruction);
-
-            // Display the binary string.
-            wattron(side, COLOR_PAIR((index == file->lineNumber) ? I_DEFAULT_SCHEME : DEFAULT_SCHEME));
-            mvwaddnstr(side, index - file->windowY, 0,
-                        instrStr, (cols - 1) / 2);
-            wattroff(side, COLOR_PAIR((index == file->lineNumber) ? I_DEFAULT_SCHEME : DEFAULT_SCHEME));
-            break;
-        }
+static void updateBinaryLine(Line *line, int index) {
+    LineAssembly *assembly = &line->assembly;
+
+    // Parse errors take precedence, then duplicate labels, then translation errors.
+    char duplicateError[64];
+    const char *error = assembly->parseError;
+    if (error == NULL && assembly->duplicate) {
+        snprintf(duplicateError, sizeof(duplicateError), "Duplicate label named <%s>!",
+                 state.symbolTable[assembly->label].label);
+        error = duplicateError;
+    }
+    if (error == NULL && assembly->hasIR && assembly->translation.lineStatus == ERRORED) {
+        error = assembly->translation.data.error;
+    }
+
+    bool lineErrored = error != NULL;
+    if (lineErrored) {
+        // Display the error
+        wattron(side, COLOR_PAIR((index == file->lineNumber) ? I_ERROR_SCHEME : ERROR_SCHEME));
+        mvwaddnstr(side, index - file->windowY, 0, error, (cols - 1) / 2);
+        wattroff(side, COLOR_PAIR((index == file->lineNumber) ? I_ERROR_SCHEME : ERROR_SCHEME));
+    } else if (assembly->hasIR) {
+        // Convert the instruction to a string.
+        char instrStr[8 * sizeof(Instruction) + 8];
+        strBinRep(instrStr, assembly->translation.data.instruction);
 
-        default:
-            wmove(side, index - file->windowY, 0);
-            break;
+        // Display the binary string.
+        wattron(side, COLOR_PAIR((index == file->lineNumber) ? I_DEFAULT_SCHEME : DEFAULT_SCHEME));
+        mvwaddnstr(side, index - file->windowY, 0, instrStr, (cols - 1) / 2);
+        wattroff(side, COLOR_PAIR((index == file->lineNumber) ? I_DEFAULT_SCHEME : DEFAULT_SCHEME));
+    } else {
+        wmove(side, index - file->windowY, 0);
     }
 
     wclrtoeol(side);
@@ -136,7 +363,7 @@ static void strBinRep(char *str, Instruction instruction) {
 
     while (--i >= 0) {
         str[i] = '0' + (instruction & 1);
-        if (i % 5 == 0) {
+        if (i % 5 == 0 && i > 0) {
             str[--i] = ' ';
         }
         instruction >>= 1;
@@ -19,6 +19,9 @@
 #include "line.h"
 #include "state.h"
 
+/// The number of symbols below which binary mode never drops the symbols which no line uses any more.
+#define MIN_COMPACT_SYMBOLS 256
+
 extern int rows, cols;
 
 extern WINDOW *side;
@@ -27,8 +30,6 @@ extern File *file;
 
 extern EditorMode mode;
 
-extern LineInfo *lineInfo;
-
 extern jmp_buf fatalBuffer;
 
 extern char *fatalError;
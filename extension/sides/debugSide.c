@@ -10,6 +10,9 @@
 /// The last state of the registers.
 static Registers_s lastRegs;
 
+/// The description of the watchpoint hit by the last step, or empty if none was.
+static char watchpointMessage[128] = "";
+
 static void printMaybeSelected(WINDOW *win, bool selected, int row, int col, const char *fmt, ...);
 
 /// Updates the debug side panel with the current state of the registers.
@@ -54,9 +57,16 @@ void updateDebug(Registers regs) {
         wattron(side, COLOR_PAIR(ERROR_SCHEME));
         mvwprintw(side, currLine, 0, "FATAL ERROR: %s", fatalError);
         wattroff(side, COLOR_PAIR(ERROR_SCHEME));
+        currLine++;
+    }
+
+    if (watchpointMessage[0] != '\0') {
+        wattron(side, COLOR_PAIR(SELECTED_SCHEME));
+        mvwprintw(side, currLine, 0, "%s", watchpointMessage);
+        wattroff(side, COLOR_PAIR(SELECTED_SCHEME));
     }
 
-    wrefresh(side);
+    wnoutrefresh(side);
     lastRegs = *regs;
 }
 
@@ -81,4 +91,15 @@ static void printMaybeSelected(WINDOW *win, bool selected, int row, int col, con
 /// @remark This is so that if the debugger is run again it doesn't mark any lines as changed.
 void clearLastRegs(void) {
     lastRegs = createRegs();
+    watchpointMessage[0] = '\0';
+}
+
+/// Shows the watchpoint hit by the last step in the debug viewer, until the next step.
+/// @param hit The [WatchpointHit], or [NULL] if none was hit.
+void setWatchpointHit(const WatchpointHit *hit) {
+    if (hit == NULL) {
+        watchpointMessage[0] = '\0';
+    } else {
+        formatWatchpointHit(hit, watchpointMessage, sizeof(watchpointMessage));
+    }
 }
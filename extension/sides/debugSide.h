@@ -21,6 +21,7 @@
 #include "output.h"
 #include "registers.h"
 #include "state.h"
+#include "watchpoint.h"
 
 extern int rows, cols;
 
@@ -30,8 +31,6 @@ extern File *file;
 
 extern EditorMode mode;
 
-extern LineInfo *lineInfo;
-
 extern jmp_buf fatalBuffer;
 
 extern char *fatalError;
@@ -40,4 +39,6 @@ void updateDebug(Registers regs);
 
 void clearLastRegs(void);
 
+void setWatchpointHit(const WatchpointHit *hit);
+
 #endif // EXTENSION_DEBUG_SIDE_H
@@ -11,8 +11,8 @@ static void updateEditLine(unused Line *line, int index);
 
 /// Updates the edit side panel with the current state of the assembly code.
 void updateEdit(void) {
-    // Print out all lines in current window.
-    iterateLinesInWindow(file, &updateEditLine);
+    // Print out the lines in the current window which have changed.
+    iterateChangedLinesInWindow(file, &updateEditLine);
 }
 
 /// Updates the edit side panel with the current state of the assembly code.
@@ -33,7 +33,7 @@ static void updateEditLine(Line *line, int index) {
                    fatalError, (cols - 1) / 2);
         wattroff(side, (file->lineNumber == index) ? COLOR_PAIR(I_ERROR_SCHEME) : COLOR_PAIR(ERROR_SCHEME));
     } else {
-        parse(getLine(line), &state);
+        parse(viewLine(line), &state);
 
         // Write the natural language version.
         if (state.irCount == 1) {
@@ -28,8 +28,6 @@ extern File *file;
 
 extern EditorMode mode;
 
-extern LineInfo *lineInfo;
-
 extern jmp_buf fatalBuffer;
 
 extern char *fatalError;
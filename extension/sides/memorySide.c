@@ -0,0 +1,103 @@
+///
+/// memorySide.c
+/// The view of virtual memory below the registers in debug mode, which only reads the words it shows.
+///
+
+#include "memorySide.h"
+
+/// The address of the first word shown.
+static size_t topAddress = 0;
+
+/// The number of words on each row, as last drawn.
+static size_t wordsPerRow = 1;
+
+/// The number of rows of words, as last drawn.
+static size_t visibleRows = 0;
+
+/// The words shown before the last step, from [snapshotAddress].
+static uint32_t snapshot[MAX_SNAPSHOT_WORDS];
+
+/// The address of the first word in [snapshot].
+static size_t snapshotAddress = 0;
+
+/// The number of words in [snapshot].
+static size_t snapshotCount = 0;
+
+/// Clamps [topAddress] to a row boundary from which there is RAM left to show.
+static void clampTopAddress(void) {
+    size_t rowBytes = wordsPerRow * sizeof(uint32_t);
+    if (topAddress >= MEMORY_SIZE) topAddress = MEMORY_SIZE - 1;
+    topAddress -= topAddress % rowBytes;
+}
+
+/// Draws the words of [memory] which fit in the side window from [row] down.
+/// Words which differ from those in the last [snapshotMemory] are highlighted.
+/// @param memory The memory being debugged.
+/// @param row The row of the side window at which to start.
+void updateMemory(Memory memory, int row) {
+    int width = getmaxx(side);
+    int height = getmaxy(side);
+    if (row + 1 >= height) return;
+
+    // Keep rows a power of two words long, so that their addresses stay round.
+    size_t fit = (width > MEMORY_ROW_PREFIX + MEMORY_WORD_WIDTH) ? (width - MEMORY_ROW_PREFIX) / MEMORY_WORD_WIDTH : 1;
+    for (wordsPerRow = 1; wordsPerRow * 2 <= fit; wordsPerRow *= 2);
+    visibleRows = height - row - 1;
+    clampTopAddress();
+
+    mvwprintw(side, row++, 0, "MEMORY [PGUP/PGDN - SCROLL, G - GO TO]");
+
+    for (size_t i = 0; i < visibleRows; i++, row++) {
+        size_t address = topAddress + i * wordsPerRow * sizeof(uint32_t);
+        if (address >= MEMORY_SIZE) break;
+
+        mvwprintw(side, row, 0, "0x%08zx:", address);
+        for (size_t j = 0; j < wordsPerRow && address + sizeof(uint32_t) <= MEMORY_SIZE; j++) {
+            uint32_t word = readMem(memory, false, address);
+
+            size_t index = (address - snapshotAddress) / sizeof(uint32_t);
+            bool changed = address >= snapshotAddress && index < snapshotCount && snapshot[index] != word;
+
+            wattron(side, changed ? COLOR_PAIR(SELECTED_SCHEME) : A_NORMAL);
+            wprintw(side, " %08" PRIx32, word);
+            wattroff(side, changed ? COLOR_PAIR(SELECTED_SCHEME) : A_NORMAL);
+
+            address += sizeof(uint32_t);
+        }
+    }
+}
+
+/// Remembers the words currently shown, so that [updateMemory] can highlight those changed by the next step.
+/// @param memory The memory being debugged.
+void snapshotMemory(Memory memory) {
+    snapshotAddress = topAddress;
+    snapshotCount = 0;
+
+    size_t count = visibleRows * wordsPerRow;
+    if (count > MAX_SNAPSHOT_WORDS) count = MAX_SNAPSHOT_WORDS;
+    for (; snapshotCount < count; snapshotCount++) {
+        size_t address = snapshotAddress + snapshotCount * sizeof(uint32_t);
+        if (address + sizeof(uint32_t) > MEMORY_SIZE) break;
+        snapshot[snapshotCount] = readMem(memory, false, address);
+    }
+}
+
+/// Forgets the last snapshot, so that no words are highlighted.
+void clearMemorySnapshot(void) {
+    snapshotCount = 0;
+}
+
+/// Scrolls the view by whole pages of rows.
+/// @param pages The number of pages to scroll down by, or up by if negative.
+void scrollMemory(long pages) {
+    long offset = pages * (long) (visibleRows ? visibleRows : 1) * (long) (wordsPerRow * sizeof(uint32_t));
+    topAddress = (offset < 0 && (size_t) -offset > topAddress) ? 0 : topAddress + offset;
+    clampTopAddress();
+}
+
+/// Scrolls the view so that the row holding [address] is at the top.
+/// @param address The address to show.
+void showMemoryAt(size_t address) {
+    topAddress = address;
+    clampTopAddress();
+}
@@ -0,0 +1,37 @@
+///
+/// memorySide.h
+/// The view of virtual memory below the registers in debug mode, which only reads the words it shows.
+///
+
+#ifndef EXTENSION_MEMORY_SIDE_H
+#define EXTENSION_MEMORY_SIDE_H
+
+#include <inttypes.h>
+#include <ncurses.h>
+#include <stdint.h>
+
+#include "const.h"
+#include "memory.h"
+
+/// The width of the address at the start of each row, i.e., <0x00000000: >.
+#define MEMORY_ROW_PREFIX 12
+
+/// The width of each word in a row, including its separating space.
+#define MEMORY_WORD_WIDTH 9
+
+/// The maximum number of words remembered by [snapshotMemory].
+#define MAX_SNAPSHOT_WORDS 4096
+
+extern WINDOW *side;
+
+void updateMemory(Memory memory, int row);
+
+void snapshotMemory(Memory memory);
+
+void clearMemorySnapshot(void);
+
+void scrollMemory(long pages);
+
+void showMemoryAt(size_t address);
+
+#endif // EXTENSION_MEMORY_SIDE_H
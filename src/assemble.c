@@ -7,44 +7,139 @@
 
 #include "assemble.h"
 
+/// Maps the whole of the file at [path] into memory, read-only.
+/// @param path The path of the file to map.
+/// @param[out] length The number of bytes in the file.
+/// @returns The start of the mapping, or NULL if the file is empty.
+static const char *mapSource(const char *path, size_t *length) {
+    int fd = open(path, O_RDONLY);
+    assertFatalWithArgs(fd != -1, "Unable to open source file <%s>!", path);
+
+    struct stat sb;
+    assertFatal(fstat(fd, &sb) == 0, "Unable to get statistics on source file!");
+    *length = sb.st_size;
+
+    // [mmap] refuses zero-length mappings, and an empty source assembles to an empty image.
+    const char *source = NULL;
+    if (*length > 0) {
+        source = mmap(NULL, *length, PROT_READ, MAP_PRIVATE, fd, 0);
+        assertFatal(source != MAP_FAILED, "Unable to map source file!");
+        madvise((void *) source, *length, MADV_SEQUENTIAL);
+    }
+
+    close(fd);
+    return source;
+}
+
+/// Writes all of [length] bytes of [buffer] to the file at [path], replacing it, or to [stdout] if [path] is <->.
+/// @param path The path of the file to write.
+/// @param buffer The bytes to write.
+/// @param length The number of bytes in [buffer].
+static void writeImage(const char *path, const void *buffer, size_t length) {
+    if (!strcmp(path, "-")) {
+        writeAll(STDOUT_FILENO, buffer, length);
+        return;
+    }
+
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    assertFatalWithArgs(fd != -1, "Unable to open output file <%s>!", path);
+    writeAll(fd, buffer, length);
+    close(fd);
+}
+
 /// The entrypoint to the assembler program.
-/// @param argc Number of arguments. Should be 3.
-/// @param argv Arguments. In order: executable name, assembly in, and object code out.
+/// @param argc Number of arguments. Should be 3, plus any options.
+/// @param argv Arguments. In order: executable name, options, assembly in, and object code out.
 /// @return Program exit code.
 /// @example \code ./assemble code.s code.o \endcode
+/// @example \code ./assemble -s code.s code.o \endcode to assemble in a single pass.
+/// @example \code ./assemble -j 4 code.s code.o \endcode to assemble with at most 4 threads.
+/// @example \code ./assemble -c code.s code.o \endcode to assemble into a relocatable object for [link].
+/// @example \code generate | ./assemble - - | consume \endcode to stream from [stdin] to [stdout].
 int main(int argc, char **argv) {
-    // Check that [argv] is valid, i.e., has 3 args.
-    if (argc != 3) {
-        printf("Usage: ./assemble code.s out.bin\n");
+    // With -s, each instruction is translated as it is parsed, and forward references are patched later.
+    // With -j, at most the given number of threads are used, rather than one per online processor.
+    // With -c, a relocatable object is written instead of a binary, to be combined with others by the linker.
+    bool singlePass = false;
+    bool object = false;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    int option;
+    while ((option = getopt(argc, argv, "scj:")) != -1) {
+        if (option == 's') {
+            singlePass = true;
+        } else if (option == 'c') {
+            object = true;
+        } else if (option == 'j' && (threads = strtol(optarg, NULL, 10)) > 0) {
+            continue;
+        } else {
+            printf("Usage: ./assemble [-s | -c] [-j threads] code.s out.bin\n");
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Check that [argv] is valid, i.e., has 2 args after the options.
+    // Objects are always assembled from a file, in two passes.
+    if (argc - optind != 2 || (object && (singlePass || !strcmp(argv[optind], "-")))) {
+        printf("Usage: ./assemble [-s | -c] [-j threads] code.s out.bin\n");
         return EXIT_FAILURE;
     };
 
-    // First pass, populate program [state] and generate [IR]s.
-    FILE *fileIn = fopen(argv[1], "r");
-    AssemblerState state = createState();
-    char line[256];
+    // A source of <-> is streamed from [stdin], which is always in a single pass.
+    if (!strcmp(argv[optind], "-")) {
+        int out = STDOUT_FILENO;
+        if (strcmp(argv[optind + 1], "-")) {
+            out = open(argv[optind + 1], O_WRONLY | O_CREAT | O_TRUNC, 0666);
+            assertFatalWithArgs(out != -1, "Unable to open output file <%s>!", argv[optind + 1]);
+        }
+
+        assembleStream(STDIN_FILENO, out);
+        if (out != STDOUT_FILENO) close(out);
+        return EXIT_SUCCESS;
+    }
+
+    size_t length;
+    const char *source = mapSource(argv[optind], &length);
 
-    while (fgets(line, sizeof(line), fileIn)) {
-        parse(line, &state);
+    if (object) {
+        int out = STDOUT_FILENO;
+        if (strcmp(argv[optind + 1], "-")) {
+            out = open(argv[optind + 1], O_WRONLY | O_CREAT | O_TRUNC, 0666);
+            assertFatalWithArgs(out != -1, "Unable to open output file <%s>!", argv[optind + 1]);
+        }
+
+        writeObject(source, length, out);
+        if (out != STDOUT_FILENO) close(out);
+        if (source != NULL) munmap((void *) source, length);
+        return EXIT_SUCCESS;
     }
 
-    fclose(fileIn);
+    if (singlePass) {
+        AssemblerState state = createState();
+        state.singlePass = true;
 
-    // Second pass, translate IRs to binary instruction based on [state].
-    FILE *fileOut = fopen(argv[2], "wb");
+        // Translate each instruction as it is parsed, patching forward references once their labels are known.
+        const char *cursor = source;
+        const char *end = source + length;
+        while (cursor != end) {
+            cursor = parseLine(cursor, end, &state);
+        }
 
-    // Reset current address - jump offset calculations rely on this.
-    state.address = 0x0;
+        // Labels are interned into the [state], so the source is no longer needed.
+        if (source != NULL) munmap((void *) source, length);
 
-    for (size_t i = 0; i < state.irCount; i++) {
-        IR ir = state.irList[i];
-        Instruction instruction = getTranslator(&ir.type)(&ir, &state);
-        state.address += 0x4;
-        fwrite(&instruction, sizeof(Instruction), 1, fileOut);
+        assertResolved(&state);
+        writeImage(argv[optind + 1], state.image, state.imageCount * sizeof(Instruction));
+        destroyState(state);
+        return EXIT_SUCCESS;
     }
 
-    destroyState(state);
-    fclose(fileOut);
+    // Otherwise, parse then translate the source in chunks spread over the [threads].
+    size_t count;
+    Instruction *image = assembleParallel(source, length, threads, &count);
+    if (source != NULL) munmap((void *) source, length);
+
+    writeImage(argv[optind + 1], image, count * sizeof(Instruction));
+    free(image);
 
     return EXIT_SUCCESS;
 }
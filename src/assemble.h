@@ -12,9 +12,17 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <sys/fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "assemblerDelegate.h"
 #include "helpers.h"
+#include "objectWriter.h"
+#include "parallel.h"
+#include "stream.h"
 
 int main(int argc, char **argv);
 
@@ -0,0 +1,59 @@
+///
+/// arena.c
+/// A bump-pointer allocator for memory that lives as long as an assembly job.
+///
+
+#include "arena.h"
+
+/// Creates an empty [Arena].
+/// @returns An [Arena] holding no memory.
+Arena createArena(void) {
+    return (Arena) { .head = NULL };
+}
+
+/// Allocates memory from [arena], suitably aligned for any type.
+/// @param arena The [Arena] to allocate from.
+/// @param size The number of bytes to allocate.
+/// @returns Pointer to the allocated memory, valid until [freeArena].
+void *arenaAlloc(Arena *arena, size_t size) {
+    // Round up, so that the next allocation stays aligned.
+    size = (size + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1);
+
+    ArenaBlock *block = arena->head;
+    if (block == NULL || block->size - block->used < size) {
+        size_t blockSize = size > ARENA_BLOCK_SIZE ? size : ARENA_BLOCK_SIZE;
+        block = malloc(sizeof(ArenaBlock) + blockSize);
+        assertFatalNotNull(block, "<Memory> Unable to allocate [ArenaBlock]!");
+        *block = (ArenaBlock) { .next = arena->head, .used = 0, .size = blockSize };
+        arena->head = block;
+    }
+
+    void *result = block->data + block->used;
+    block->used += size;
+    return result;
+}
+
+/// Copies at most [length] characters of [str] into [arena], null-terminated.
+/// @param arena The [Arena] to allocate from.
+/// @param str The string to copy.
+/// @param length The maximum number of characters to copy.
+/// @returns The copy, valid until [freeArena].
+char *arenaStrndup(Arena *arena, const char *str, size_t length) {
+    length = strnlen(str, length);
+    char *result = arenaAlloc(arena, length + 1);
+    memcpy(result, str, length);
+    result[length] = '\0';
+    return result;
+}
+
+/// Frees all memory allocated from [arena] at once.
+/// @param arena The [Arena] to free.
+void freeArena(Arena *arena) {
+    ArenaBlock *block = arena->head;
+    while (block != NULL) {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->head = NULL;
+}
@@ -0,0 +1,52 @@
+///
+/// arena.h
+/// A bump-pointer allocator for memory that lives as long as an assembly job.
+///
+
+#ifndef ASSEMBLER_ARENA_H
+#define ASSEMBLER_ARENA_H
+
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "error.h"
+
+/// The usable size of a regular [ArenaBlock]. Larger allocations get a block of their own.
+#define ARENA_BLOCK_SIZE (64 * 1024)
+
+/// A block of memory handed out by an [Arena].
+typedef struct ArenaBlock {
+
+    /// The previously filled block, or NULL if this is the first.
+    struct ArenaBlock *next;
+
+    /// The number of bytes of [data] handed out.
+    size_t used;
+
+    /// The number of bytes in [data].
+    size_t size;
+
+    /// The memory handed out.
+    alignas(max_align_t) char data[];
+
+} ArenaBlock;
+
+/// A bump-pointer allocator, whose allocations are all freed together.
+typedef struct {
+
+    /// The block currently being handed out, or NULL if nothing has been allocated.
+    ArenaBlock *head;
+
+} Arena;
+
+Arena createArena(void);
+
+void *arenaAlloc(Arena *arena, size_t size);
+
+char *arenaStrndup(Arena *arena, const char *str, size_t length);
+
+void freeArena(Arena *arena);
+
+#endif // ASSEMBLER_ARENA_H
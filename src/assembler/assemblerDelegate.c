@@ -7,126 +7,175 @@
 
 #include "assemblerDelegate.h"
 
-static const ParserEntry parsers[] = {
-    { "",     parseDirective },
-    { "add",  parseDataProcessing },
-    { "adds", parseDataProcessing },
-    { "and",  parseRegister },
-    { "ands", parseRegister },
-    { "b",    parseBranch },
-    { "bic",  parseRegister },
-    { "bics", parseRegister },
-    { "br",   parseBranch },
-    { "cmn",  parseDataProcessing },
-    { "cmp",  parseDataProcessing },
-    { "eon",  parseRegister },
-    { "eor",  parseRegister },
-    { "ldr",  parseLoadStore },
-    { "madd", parseRegister },
-    { "mneg", parseDataProcessing },
-    { "mov",  parseDataProcessing },
-    { "movk", parseImmediate },
-    { "movn", parseImmediate },
-    { "movz", parseImmediate },
-    { "msub", parseRegister },
-    { "mul",  parseDataProcessing },
-    { "mvn",  parseRegister },
-    { "neg",  parseDataProcessing },
-    { "negs", parseDataProcessing },
-    { "orn",  parseRegister },
-    { "orr",  parseRegister },
-    { "str",  parseLoadStore },
-    { "sub",  parseDataProcessing },
-    { "subs", parseDataProcessing },
-    { "tst",  parseDataProcessing },
-};
+/// An entry of [mnemonics] for an instruction, keyed on its characters.
+#define INSTRUCTION(c0, c1, c2, c3, parser) \
+    [MNEMONIC_SLOT(MNEMONIC_KEY(c0, c1, c2, c3))] = { MNEMONIC_KEY(c0, c1, c2, c3), parser, NULL, 0, 0 }
+
+/// An entry of [mnemonics] for an alias, keyed on its characters, which expands to the instruction [alias].
+#define ALIAS(c0, c1, c2, c3, parser, alias, zeroIndex, operandCount) \
+    [MNEMONIC_SLOT(MNEMONIC_KEY(c0, c1, c2, c3))] = \
+        { MNEMONIC_KEY(c0, c1, c2, c3), parser, alias, zeroIndex, operandCount }
 
-static const TranslatorEntry translators[] = {
-    { IMMEDIATE,  translateImmediate },
-    { REGISTER,   translateRegister },
-    { LOAD_STORE, translateLoadStore },
-    { BRANCH,     translateBranch },
-    { DIRECTIVE,  translateDirective },
+/// The perfect hash table of all mnemonics, indexed by [MNEMONIC_SLOT].
+/// Should two mnemonics share a slot, the overriding initialiser fails the build.
+static const MnemonicEntry mnemonics[1 << MNEMONIC_SLOT_BITS] = {
+    INSTRUCTION(0,   0,   0,   0,   parseDirective),
+    INSTRUCTION('a', 'd', 'd', 0,   parseDataProcessing),
+    INSTRUCTION('a', 'd', 'd', 's', parseDataProcessing),
+    INSTRUCTION('a', 'n', 'd', 0,   parseRegister),
+    INSTRUCTION('a', 'n', 'd', 's', parseRegister),
+    INSTRUCTION('b', 0,   0,   0,   parseBranch),
+    INSTRUCTION('b', 'i', 'c', 0,   parseRegister),
+    INSTRUCTION('b', 'i', 'c', 's', parseRegister),
+    INSTRUCTION('b', 'r', 0,   0,   parseBranch),
+    ALIAS('c', 'm', 'n', 0,         parseDataProcessing, "adds", 0, 0),
+    ALIAS('c', 'm', 'p', 0,         parseDataProcessing, "subs", 0, 0),
+    INSTRUCTION('e', 'o', 'n', 0,   parseRegister),
+    INSTRUCTION('e', 'o', 'r', 0,   parseRegister),
+    INSTRUCTION('h', 'l', 't', 0,   parseSystem),
+    INSTRUCTION('l', 'd', 'r', 0,   parseLoadStore),
+    INSTRUCTION('m', 'a', 'd', 'd', parseRegister),
+    ALIAS('m', 'n', 'e', 'g',       parseRegister, "msub", 3, 3),
+    ALIAS('m', 'o', 'v', 0,         parseRegister, "orr", 1, 2),
+    INSTRUCTION('m', 'o', 'v', 'k', parseImmediate),
+    INSTRUCTION('m', 'o', 'v', 'n', parseImmediate),
+    INSTRUCTION('m', 'o', 'v', 'z', parseImmediate),
+    INSTRUCTION('m', 'r', 's', 0,   parseSystem),
+    INSTRUCTION('m', 's', 'u', 'b', parseRegister),
+    ALIAS('m', 'u', 'l', 0,         parseRegister, "madd", 3, 3),
+    ALIAS('m', 'v', 'n', 0,         parseRegister, "orn", 1, 0),
+    ALIAS('n', 'e', 'g', 0,         parseDataProcessing, "sub", 1, 0),
+    ALIAS('n', 'e', 'g', 's',       parseDataProcessing, "subs", 1, 0),
+    INSTRUCTION('o', 'r', 'n', 0,   parseRegister),
+    INSTRUCTION('o', 'r', 'r', 0,   parseRegister),
+    INSTRUCTION('s', 't', 'r', 0,   parseLoadStore),
+    INSTRUCTION('s', 'u', 'b', 0,   parseDataProcessing),
+    INSTRUCTION('s', 'u', 'b', 's', parseDataProcessing),
+    ALIAS('t', 's', 't', 0,         parseRegister, "ands", 0, 0),
 };
 
-/// Performs [strcmp] on the [mnemonic]s of [ParserEntry]s, but takes in [void *]s.
-/// @param v1 The first item.
-/// @param v2 The second item.
-/// @returns [int] of comparison.
-static int parserCmp(const void *v1, const void *v2) {
-    const ParserEntry *p1 = (const ParserEntry *) v1;
-    const ParserEntry *p2 = (const ParserEntry *) v2;
-    return strcmp(p1->mnemonic, p2->mnemonic);
-}
+/// The [Translator] of each [IRType], indexed by the type.
+static const Translator translators[] = {
+    [IMMEDIATE]  = translateImmediate,
+    [REGISTER]   = translateRegister,
+    [LOAD_STORE] = translateLoadStore,
+    [BRANCH]     = translateBranch,
+    [DIRECTIVE]  = translateDirective,
+    [SYSTEM]     = translateSystem,
+};
 
-/// Gets the corresponding [Parser] for [mnemonic].
+/// Gets the [MnemonicEntry] for [mnemonic] with a single probe of the perfect hash table.
 /// @param mnemonic The mnemonic to search for.
-/// @returns The corresponding [Parser]
-Parser getParser(const char *mnemonic) {
-    ParserEntry target = (ParserEntry) { mnemonic, NULL };
-    ParserEntry *entry = bsearch(&target, parsers, sizeof(parsers) / sizeof(ParserEntry),
-                                 sizeof(ParserEntry), parserCmp);
-    assertFatalNotNullWithArgs(entry, "No Parser found for mnemonic <%s>!", mnemonic);
-    return entry->handler;
-}
+/// @returns The corresponding [MnemonicEntry].
+const MnemonicEntry *getMnemonic(const char *mnemonic) {
+    // Mnemonics longer than four characters cannot have a key, so cannot be valid.
+    uint32_t key = 0;
+    for (int i = 0; mnemonic[i] != '\0'; i++) {
+        assertFatalWithArgs(i < 4, "No Parser found for mnemonic <%s>!", mnemonic);
+        key |= (uint32_t) (uint8_t) mnemonic[i] << (8 * i);
+    }
 
-/// Performs comparison on the [type]s of [TranslatorEntry]s, but takes in [void *]s.
-/// @param v1 The first item.
-/// @param v2 The second item.
-/// @returns [int] of comparison.
-static int translatorCmp(const void *v1, const void *v2) {
-    const TranslatorEntry *p1 = (const TranslatorEntry *) v1;
-    const TranslatorEntry *p2 = (const TranslatorEntry *) v2;
-    return p1->type - p2->type;
+    const MnemonicEntry *entry = &mnemonics[MNEMONIC_SLOT(key)];
+    assertFatalWithArgs(entry->handler != NULL && entry->key == key, "No Parser found for mnemonic <%s>!", mnemonic);
+    return entry;
 }
 
-/// Gets the corresponding [Parser] for [mnemonic].
-/// @param mnemonic The mnemonic to search for.
-/// @returns The corresponding [Parser]
+/// Gets the corresponding [Translator] for [type].
+/// @param type The [IRType] to translate.
+/// @returns The corresponding [Translator].
 Translator getTranslator(const IRType *type) {
-    TranslatorEntry target = (TranslatorEntry) { *type, NULL };
-    TranslatorEntry *entry = bsearch(&target, translators, sizeof(translators) / sizeof(TranslatorEntry),
-                                     sizeof(TranslatorEntry), translatorCmp);
-    assertFatalNotNullWithArgs(entry, "No Translator found for type <%s>!", type);
-    return entry->handler;
+    assertFatalWithArgs(*type < sizeof(translators) / sizeof(Translator), "No Translator found for type <%d>!", *type);
+    return translators[*type];
 }
 
-/// Parses [line] into its IR form, and adds it to [state].
-/// @param line The assembly instruction to parse.
-/// @param state The [AssemblerState] to modify.
-void parse(char *line, AssemblerState *state) {
-    char *trimmedLine = trim(line, WHITESPACE);
-
-    // End the line where a comment starts.
-    char *commentStart = strstr(trimmedLine, "//");
-    if (commentStart != NULL) {
-        *commentStart = '\0';
+/// Parses the instruction or directive of a [TokenisedLine] into its IR form, expanding any alias.
+/// @param line The [TokenisedLine], which must have an instruction.
+/// @param state The [AssemblerState] in which any referenced label is interned.
+/// @returns The [IR] of the instruction.
+IR parseInstruction(TokenisedLine *line, AssemblerState *state) {
+    const MnemonicEntry *entry = getMnemonic(line->mnemonic);
+    if (entry->alias != NULL) {
+        expandAlias(line, entry->alias, entry->zeroIndex, entry->operandCount);
     }
 
-    // Check if line is blank.
-    if (strlen(trimmedLine) == 0) return;
+    return entry->handler(line, state);
+}
+
+/// Translates the instructions that were waiting on the label [id], now that it is defined.
+/// @param state The [AssemblerState] to modify.
+/// @param id The symbol ID of the newly defined label.
+static void resolveFixups(AssemblerState *state, size_t id) {
+    // Jump offset calculations rely on [address] being that of the instruction being translated.
+    BitData address = state->address;
+    struct Fixup fixup;
+    while (takeFixup(state, id, &fixup)) {
+        state->address = fixup.address;
+        state->image[fixup.address / 0x4 - state->imageBase] = getTranslator(&fixup.ir.type)(&fixup.ir, state);
+    }
+    state->address = address;
+}
 
-    // Check if line is a label.
-    char *colon = strchr(line, ':');
-    if (colon != NULL) {
-        // Process as label if first character is valid.
-        if (isalpha(line[0]) || line[0] == '_' || line[0] == '.') {
-            char *label = strdup(line);
-            assertFatalNotNull(label, "<Memory> Unable to duplicate [char *]!");
-            *strchr(label, ':') = '\0';
+/// Translates [ir] into the image of [state] straight away, or defers it if it references an undefined label.
+/// @param state The [AssemblerState] to modify.
+/// @param ir The [IR] of the instruction at the current address.
+static void emitIR(AssemblerState *state, IR ir) {
+    Literal *literal = getLabelLiteral(&ir);
+    if (literal != NULL && getMapping(state, literal->data.label.id) == NULL) {
+        // Hold the instruction's place in the image until [resolveFixups] patches it.
+        addFixup(state, literal->data.label.id, ir);
+        addInstruction(state, 0x0);
+    } else {
+        addInstruction(state, getTranslator(&ir.type)(&ir, state));
+    }
+}
 
-            addMapping(state, label, state->address);
-            return;
-        };
+/// Parses the line at [cursor] into its IR form, and adds it and any label it defines to [state].
+/// In single-pass mode, the instruction is translated into the image of [state] instead of kept as IR.
+/// @param cursor The start of the line to parse.
+/// @param end The end of the source, which need not be null-terminated.
+/// @param state The [AssemblerState] to modify.
+/// @returns The start of the next line, or [end].
+const char *parseLine(const char *cursor, const char *end, AssemblerState *state) {
+    TokenisedLine tokenisedLine;
+    cursor = tokenise(cursor, end, &tokenisedLine);
 
-        throwFatalWithArgs("Invalid label named <%s>!", line);
+    if (tokenisedLine.label != NULL) {
+        size_t id = addMapping(state, tokenisedLine.label, tokenisedLine.labelLength, state->address);
+        if (state->singlePass) resolveFixups(state, id);
     }
 
     // By default, handle either directive or instructions.
-    TokenisedLine tokenisedLine = tokenise(line);
-    IR ir = getParser(tokenisedLine.mnemonic)(&tokenisedLine, state);
+    if (tokenisedLine.hasInstruction) {
+        IR ir = parseInstruction(&tokenisedLine, state);
+        if (state->singlePass) {
+            emitIR(state, ir);
+            state->address += 0x4;
+        } else {
+            state->address += 0x4;
+            addIR(state, ir);
+        }
+    }
+
+    return cursor;
+}
 
-    state->address += 0x4;
-    destroyTokenisedLine(&tokenisedLine);
-    addIR(state, ir);
+/// Checks that no instruction is still waiting on a label at the end of a single-pass assembly.
+/// @param state The [AssemblerState] to check.
+/// @throw UndefinedLabel Will fatal error if some referenced label was never defined.
+void assertResolved(AssemblerState *state) {
+    if (state->fixupCount == 0) return;
+    for (size_t id = 0; id < state->symbolCount; id++) {
+        assertFatalWithArgs(state->symbolTable[id].fixups == 0,
+                            "No mapping for label named <%s>!", state->symbolTable[id].label);
+    }
+}
+
+/// Parses [line] into its IR form, and adds it to [state].
+/// @param line The assembly instruction to parse.
+/// @param state The [AssemblerState] to modify.
+void parse(const char *line, AssemblerState *state) {
+    const char *end = line + strlen(line);
+    while (line != end) {
+        line = parseLine(line, end, state);
+    }
 }
@@ -23,41 +23,63 @@
 #include "helpers.h"
 #include "immediateParser.h"
 #include "immediateTranslator.h"
+#include "lexer.h"
 #include "ir.h"
 #include "loadStoreParser.h"
 #include "loadStoreTranslator.h"
 #include "registerParser.h"
 #include "registerTranslator.h"
 #include "state.h"
+#include "systemParser.h"
+#include "systemTranslator.h"
 
 /// A function which processes a tokenised assembly instruction into its intermediate representation.
 typedef IR (*Parser)(TokenisedLine *line, AssemblerState *state);
 
-/// An entry in an [Parser] table.
+/// The number of bits in a slot of the mnemonic table, which has [1 << MNEMONIC_SLOT_BITS] slots.
+#define MNEMONIC_SLOT_BITS 6
+
+/// Packs the characters of a mnemonic into its key, which is unique as no mnemonic is longer than four characters.
+#define MNEMONIC_KEY(c0, c1, c2, c3) \
+    ((uint32_t) (c0) | (uint32_t) (c1) << 8 | (uint32_t) (c2) << 16 | (uint32_t) (c3) << 24)
+
+/// Hashes the key of a mnemonic to its slot in the mnemonic table.
+/// The multiplier was searched for so that no two mnemonics share a slot, which the table's initialiser checks.
+#define MNEMONIC_SLOT(key) ((uint32_t) ((key) * 0x5AC622DBU) >> (32 - MNEMONIC_SLOT_BITS))
+
+/// An entry in the mnemonic table, holding everything needed to parse a line with that mnemonic.
 typedef struct {
 
-    const char *mnemonic;
+    /// The key of the mnemonic, from [MNEMONIC_KEY].
+    uint32_t key;
+
+    /// The parser of the instruction, or of the instruction that it is an alias of. NULL for an empty slot.
+    Parser handler;
+
+    /// For an alias, the mnemonic of the instruction it stands for. Otherwise, NULL.
+    const char *alias;
 
-    const Parser handler;
+    /// For an alias, the index of the token to insert the zero register before.
+    int zeroIndex;
 
-} ParserEntry;
+    /// For an alias, the number of operands it takes, or 0 if [handler] checks them.
+    int operandCount;
+
+} MnemonicEntry;
 
 /// A function which produces a binary word instruction given its intermediate representation.
 typedef Instruction (*Translator)(IR *irObject, AssemblerState *state);
 
-/// An entry in an [Translator] table.
-typedef struct {
-
-    const IRType type;
+const MnemonicEntry *getMnemonic(const char *mnemonic);
 
-    const Translator handler;
+Translator getTranslator(const IRType *type);
 
-} TranslatorEntry;
+IR parseInstruction(TokenisedLine *line, AssemblerState *state);
 
-Parser getParser(const char *mnemonic);
+const char *parseLine(const char *cursor, const char *end, AssemblerState *state);
 
-Translator getTranslator(const IRType *type);
+void parse(const char *line, AssemblerState *state);
 
-void parse(char *line, AssemblerState *state);
+void assertResolved(AssemblerState *state);
 
 #endif // ASSEMBLER_DELEGATE_H
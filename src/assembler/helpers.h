@@ -17,37 +17,23 @@
 #include "const.h"
 #include "error.h"
 #include "ir.h"
+#include "lexer.h"
 #include "state.h"
 
-/// A tokenised assembly instruction.
-typedef struct {
-
-    int operandCount;  /// The number of operands parsed.
-
-    char *mnemonic;    /// The instruction mnemonic.
-
-    char *subMnemonic; /// The second part of the mnemonic after '.', if present.
-
-    char **operands;   /// The list of operands.
-
-} TokenisedLine;
-
 char *trim(char *str, const char *except);
 
-char **split(const char *str, const char *delim, int *count);
-
-TokenisedLine tokenise(const char *line);
+bool hasToken(const TokenisedLine *line, int index, TokenType type);
 
-void destroyTokenisedLine(TokenisedLine *line);
+const Token *expectToken(const TokenisedLine *line, int index, TokenType type);
 
-Literal parseLiteral(const char *literal);
+Literal parseLiteralToken(const TokenisedLine *line, int index, AssemblerState *state);
 
-uint8_t parseRegisterStr(const char *name, bool *sf);
+uint8_t parseRegisterToken(const TokenisedLine *line, int index, bool *sf);
 
-uint64_t parseImmediateStr(const char *operand, size_t width);
+uint64_t parseImmediateToken(const TokenisedLine *line, int index, size_t width);
 
 void parseOffset(union LiteralData *data, AssemblerState *state);
 
-int strcmpVoid(const void *v1, const void *v2);
+Literal *getLabelLiteral(IR *ir);
 
 #endif // ASSEMBLER_HELPERS_H
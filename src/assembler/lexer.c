@@ -0,0 +1,235 @@
+///
+/// lexer.c
+/// Splits a line of assembly into a [TokenisedLine] of typed tokens in a single scan.
+///
+
+#include "lexer.h"
+
+/// Checks whether [c] may start a name, i.e., a mnemonic, label, register, or shift.
+/// @param c The character to check.
+/// @returns Whether [c] may start a name.
+static bool isNameStart(char c) {
+    return isalpha((unsigned char) c) || c == '_' || c == '.';
+}
+
+/// Checks whether [c] may continue a name.
+/// @param c The character to check.
+/// @returns Whether [c] may continue a name.
+static bool isNameChar(char c) {
+    return isalnum((unsigned char) c) || c == '_' || c == '.' || c == '$';
+}
+
+/// Skips spaces, tabs, and carriage returns.
+/// @param cursor The current position in the source.
+/// @param end The end of the source.
+/// @returns The position of the next other character, or [end].
+static const char *skipBlanks(const char *cursor, const char *end) {
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) cursor++;
+    return cursor;
+}
+
+/// Checks whether nothing but a comment is left of the line at [cursor].
+/// @param cursor The current position in the source.
+/// @param end The end of the source.
+/// @returns Whether [cursor] is at the end of the line, the source, or a comment.
+static bool atLineEnd(const char *cursor, const char *end) {
+    return cursor == end || *cursor == '\n' || (*cursor == '/' && cursor + 1 < end && cursor[1] == '/');
+}
+
+/// Skips a name.
+/// @param cursor The current position in the source.
+/// @param end The end of the source.
+/// @returns The position just past the name, which is [cursor] if there is none.
+static const char *scanName(const char *cursor, const char *end) {
+    while (cursor < end && isNameChar(*cursor)) cursor++;
+    return cursor;
+}
+
+/// Scans a decimal or hexadecimal (0x) integer, with an optional sign.
+/// @param cursor The current position in the source, after any <#>.
+/// @param end The end of the source.
+/// @param[out] value The value of the integer.
+/// @returns The position just past the integer.
+static const char *scanImmediate(const char *cursor, const char *end, int64_t *value) {
+    const char *start = cursor;
+    bool negative = false;
+    if (cursor < end && (*cursor == '-' || *cursor == '+')) negative = *cursor++ == '-';
+
+    uint64_t result = 0;
+    const char *digits = cursor;
+    if (end - cursor > 2 && cursor[0] == '0' && (cursor[1] | 0x20) == 'x' && isxdigit((unsigned char) cursor[2])) {
+        cursor += 2;
+        digits = cursor;
+        for (; cursor < end && isxdigit((unsigned char) *cursor); cursor++) {
+            result = result * 16 + (isdigit((unsigned char) *cursor) ? *cursor - '0' : (*cursor | 0x20) - 'a' + 10);
+        }
+    } else {
+        for (; cursor < end && isdigit((unsigned char) *cursor); cursor++) {
+            result = result * 10 + (*cursor - '0');
+        }
+    }
+
+    // The integer must have digits, and not run on into a name.
+    const char *tokenEnd = scanName(cursor, end);
+    assertFatalWithArgs(cursor != digits && tokenEnd == cursor,
+                        "Invalid immediate value <%.*s>!", (int) (tokenEnd - start), start);
+
+    *value = negative ? -(int64_t) result : (int64_t) result;
+    return cursor;
+}
+
+/// Classifies a name in the operands as a register, a shift, or a label.
+/// @param start The first character of the name.
+/// @param length The number of characters in the name.
+/// @returns The [Token] of the name.
+static Token classifyName(const char *start, size_t length) {
+    char lower[4] = { 0 };
+    for (size_t i = 0; i < length && i < 3; i++) lower[i] = (char) tolower((unsigned char) start[i]);
+
+    // Registers: <x> or <w>, then a number, <zr>, or <sp>; or just <sp>.
+    if ((lower[0] == 'x' || lower[0] == 'w') && (length == 2 || length == 3)) {
+        Token token = { .type = TOKEN_REGISTER, .data.reg.sf = lower[0] == 'x' };
+        if (isdigit((unsigned char) lower[1]) && (length == 2 || isdigit((unsigned char) lower[2]))) {
+            int id = length == 2 ? lower[1] - '0' : (lower[1] - '0') * 10 + lower[2] - '0';
+            assertFatalWithArgs(id < 32, "Register <%d> out of bounds!", id);
+            token.data.reg.id = id;
+            return token;
+        } else if (length == 3 && (!strcmp(lower + 1, "zr") || !strcmp(lower + 1, "sp"))) {
+            token.data.reg.id = 0x1F;
+            return token;
+        }
+    } else if (length == 2 && !strcmp(lower, "sp")) {
+        return (Token) { .type = TOKEN_REGISTER, .data.reg = { .id = 0x1F, .sf = true } };
+    } else if (length == 3) {
+        static const char *shifts[] = { [LSL] = "lsl", [LSR] = "lsr", [ASR] = "asr", [ROR] = "ror" };
+        for (size_t i = 0; i < sizeof(shifts) / sizeof(char *); i++) {
+            if (!strcmp(lower, shifts[i])) return (Token) { .type = TOKEN_SHIFT, .data.shift = i };
+        }
+    }
+
+    return (Token) { .type = TOKEN_LABEL, .data.label = { .start = start, .length = length } };
+}
+
+/// Copies a part of a mnemonic into [buffer] in lower case.
+/// @param start The first character of the part.
+/// @param end The end of the part.
+/// @param buffer The buffer of [MAX_MNEMONIC_LENGTH] characters to copy into.
+static void copyMnemonic(const char *start, const char *end, char *buffer) {
+    assertFatalWithArgs(end - start < MAX_MNEMONIC_LENGTH,
+                        "Invalid mnemonic <%.*s>!", (int) (end - start), start);
+    for (; start < end; start++) *buffer++ = (char) tolower((unsigned char) *start);
+    *buffer = '\0';
+}
+
+/// Lexes the operands of an instruction into [line].
+/// @param cursor The current position in the source, at the first operand.
+/// @param end The end of the source.
+/// @param line The [TokenisedLine] to add the operands to.
+/// @returns The position just past the operands.
+static const char *lexOperands(const char *cursor, const char *end, TokenisedLine *line) {
+    while (!atLineEnd(cursor, end)) {
+        char c = *cursor;
+        if (c == ',') {
+            line->operandCount++;
+            cursor = skipBlanks(cursor + 1, end);
+            continue;
+        }
+
+        assertFatalWithArgs(line->tokenCount < MAX_TOKENS, "Too many operands for <%s>!", line->mnemonic);
+        Token *token = &line->tokens[line->tokenCount++];
+
+        switch (c) {
+            case '[':
+                token->type = TOKEN_OPEN_BRACKET;
+                cursor++;
+                break;
+
+            case ']':
+                token->type = TOKEN_CLOSE_BRACKET;
+                cursor++;
+                break;
+
+            case '!':
+                token->type = TOKEN_EXCLAMATION;
+                cursor++;
+                break;
+
+            case '#':
+                token->type = TOKEN_IMMEDIATE;
+                cursor = scanImmediate(cursor + 1, end, &token->data.immediate);
+                break;
+
+            default:
+                if (isdigit((unsigned char) c) || c == '-' || c == '+') {
+                    // Bare integers, as used by directives.
+                    token->type = TOKEN_IMMEDIATE;
+                    cursor = scanImmediate(cursor, end, &token->data.immediate);
+                } else if (isNameStart(c)) {
+                    const char *start = cursor;
+                    cursor = scanName(cursor, end);
+                    *token = classifyName(start, cursor - start);
+                } else {
+                    throwFatalWithArgs("Unexpected character <%c>!", c);
+                }
+        }
+
+        cursor = skipBlanks(cursor, end);
+    }
+
+    // There is one more operand than there are commas.
+    if (line->tokenCount > 0) line->operandCount++;
+    return cursor;
+}
+
+/// Tokenises the line of assembly at [cursor] into its [TokenisedLine] form.
+/// @param cursor The start of the line.
+/// @param end The end of the source, which need not be null-terminated.
+/// @param[out] line The [TokenisedLine], whose labels are views into the source.
+/// @returns The start of the next line, or [end].
+/// @throw InvalidInstruction Will fatal error if the line cannot be tokenised. This is not a post-condition!
+const char *tokenise(const char *cursor, const char *end, TokenisedLine *line) {
+    line->label = NULL;
+    line->labelLength = 0;
+    line->hasInstruction = false;
+    line->mnemonic[0] = '\0';
+    line->subMnemonic[0] = '\0';
+    line->operandCount = 0;
+    line->tokenCount = 0;
+
+    cursor = skipBlanks(cursor, end);
+    const char *name = cursor;
+    const char *nameEnd = cursor = scanName(cursor, end);
+    cursor = skipBlanks(cursor, end);
+
+    // A name followed by ':' defines a label, which an instruction may follow.
+    if (cursor < end && *cursor == ':') {
+        assertFatalWithArgs(name != nameEnd && isNameStart(*name),
+                            "Invalid label named <%.*s>!", (int) (nameEnd - name), name);
+        line->label = name;
+        line->labelLength = nameEnd - name;
+
+        name = skipBlanks(cursor + 1, end);
+        nameEnd = cursor = scanName(name, end);
+        cursor = skipBlanks(cursor, end);
+    }
+
+    if (name != nameEnd) {
+        line->hasInstruction = true;
+
+        // Split off the sub-mnemonic after the first '.'. Directives have an empty mnemonic.
+        const char *separator = memchr(name, '.', nameEnd - name);
+        copyMnemonic(name, separator != NULL ? separator : nameEnd, line->mnemonic);
+        if (separator != NULL) {
+            assertFatal(separator + 1 != nameEnd, "Sub-mnemonic was present but is empty!");
+            copyMnemonic(separator + 1, nameEnd, line->subMnemonic);
+        }
+
+        cursor = lexOperands(cursor, end, line);
+    }
+
+    assertFatalWithArgs(atLineEnd(cursor, end), "Unexpected character <%c>!", *cursor);
+
+    // Skip any comment, and the newline.
+    const char *newline = memchr(cursor, '\n', end - cursor);
+    return newline != NULL ? newline + 1 : end;
+}
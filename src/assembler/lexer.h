@@ -0,0 +1,123 @@
+///
+/// lexer.h
+/// Splits a line of assembly into a [TokenisedLine] of typed tokens in a single scan.
+///
+
+#ifndef ASSEMBLER_LEXER_H
+#define ASSEMBLER_LEXER_H
+
+#include <ctype.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "const.h"
+#include "error.h"
+#include "ir.h"
+
+/// The maximum length of a mnemonic or sub-mnemonic, including the null terminator.
+#define MAX_MNEMONIC_LENGTH 8
+
+/// The maximum number of tokens in the operands of a [TokenisedLine].
+#define MAX_TOKENS          8
+
+/// The type of a [Token].
+typedef enum {
+
+    /// A general-purpose register, e.g., <x0>, <w30>, or <xzr>.
+    TOKEN_REGISTER,
+
+    /// An integer, with or without a leading <#>.
+    TOKEN_IMMEDIATE,
+
+    /// Any other name, e.g., a label or a system register.
+    TOKEN_LABEL,
+
+    /// A shift type, e.g., <lsl>.
+    TOKEN_SHIFT,
+
+    /// <[>.
+    TOKEN_OPEN_BRACKET,
+
+    /// <]>.
+    TOKEN_CLOSE_BRACKET,
+
+    /// <!>.
+    TOKEN_EXCLAMATION
+
+} TokenType;
+
+/// A typed operand token.
+typedef struct {
+
+    /// The type of the token.
+    TokenType type;
+
+    /// The value of the token, by [type].
+    union TokenData {
+
+        /// [TOKEN_REGISTER].
+        struct RegisterToken {
+
+            /// The encoding of the register.
+            uint8_t id;
+
+            /// Whether the register is 64-bit.
+            bool sf;
+
+        } reg;
+
+        /// [TOKEN_IMMEDIATE].
+        int64_t immediate;
+
+        /// [TOKEN_LABEL], as a view into the source.
+        struct LabelToken {
+
+            /// The first character of the name.
+            const char *start;
+
+            /// The number of characters in the name.
+            size_t length;
+
+        } label;
+
+        /// [TOKEN_SHIFT].
+        enum ShiftType shift;
+
+    } data;
+
+} Token;
+
+/// A tokenised line of assembly.
+typedef struct {
+
+    /// The label defined at the start of the line as a view into the source, or NULL if none.
+    const char *label;
+
+    /// The number of characters in [label].
+    size_t labelLength;
+
+    /// Whether the line holds an instruction or directive, after any [label].
+    bool hasInstruction;
+
+    /// The instruction mnemonic, in lower case. Empty for directives.
+    char mnemonic[MAX_MNEMONIC_LENGTH];
+
+    /// The second part of the mnemonic after '.', e.g., a condition code or a directive. Empty if not present.
+    char subMnemonic[MAX_MNEMONIC_LENGTH];
+
+    /// The number of comma-separated operands.
+    int operandCount;
+
+    /// The number of [tokens].
+    int tokenCount;
+
+    /// The tokens of all the operands, in order.
+    Token tokens[MAX_TOKENS];
+
+} TokenisedLine;
+
+const char *tokenise(const char *cursor, const char *end, TokenisedLine *line);
+
+#endif // ASSEMBLER_LEXER_H
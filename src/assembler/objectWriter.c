@@ -0,0 +1,93 @@
+///
+/// objectWriter.c
+/// Assembles a source into a relocatable object, leaving references to labels it does not define to the linker.
+///
+
+#include "objectWriter.h"
+
+/// Gets the [RelocationType] of the field through which [ir] references a label.
+/// @param ir The [IR], which must reference a label.
+/// @returns The [RelocationType] of the field holding the label's offset.
+static RelocationType getRelocationType(const IR *ir) {
+    if (ir->type == LOAD_STORE) return RELOCATION_LITERAL19;
+    return (ir->ir.branchIR.type == BRANCH_CONDITIONAL) ? RELOCATION_CONDITIONAL19 : RELOCATION_BRANCH26;
+}
+
+/// Assembles [source] into a relocatable object with a single [TEXT_SECTION], and writes it to [out].
+/// Every label in the symbol table is exported. References to labels defined in [source] are resolved straight
+/// away, as the section moves as a whole; references to any other label become [ObjectRelocation]s.
+/// @param source The assembly source, which need not be null-terminated.
+/// @param length The number of characters in [source].
+/// @param out The file descriptor to write the object to.
+void writeObject(const char *source, size_t length, int out) {
+    AssemblerState state = createState();
+    const char *cursor = source;
+    const char *end = source + length;
+    while (cursor != end) {
+        cursor = parseLine(cursor, end, &state);
+    }
+
+    assertFatal(state.irCount <= UINT32_MAX / sizeof(Instruction), "Source is too large for an object file!");
+    Instruction *text = malloc(state.irCount * sizeof(Instruction));
+    ObjectRelocation *relocations = malloc(state.irCount * sizeof(ObjectRelocation));
+    assertFatal(text != NULL && relocations != NULL, "<Memory> Unable to allocate object!");
+    size_t relocationCount = 0;
+
+    // Translate each instruction, with a zero offset in place of any label defined elsewhere.
+    state.address = 0x0;
+    for (size_t i = 0; i < state.irCount; i++) {
+        IR ir = state.irList[i];
+        Literal *literal = getLabelLiteral(&ir);
+        if (literal != NULL && getMapping(&state, literal->data.label.id) == NULL) {
+            relocations[relocationCount++] = (ObjectRelocation) {
+                .section = 0, .offset = state.address, .symbol = literal->data.label.id,
+                .type = getRelocationType(&ir)
+            };
+            *literal = (Literal) { .isLabel = false, .data.immediate = 0 };
+        }
+
+        text[i] = getTranslator(&ir.type)(&ir, &state);
+        state.address += 0x4;
+    }
+
+    // The symbol table follows [symbolTable] exactly, so relocations can refer to symbols by their IDs.
+    ObjectSymbol *symbols = malloc(state.symbolCount * sizeof(ObjectSymbol));
+    assertFatal(symbols != NULL, "<Memory> Unable to allocate object symbols!");
+    size_t stringsLength = 0;
+    for (size_t id = 0; id < state.symbolCount; id++) {
+        const struct Symbol *symbol = &state.symbolTable[id];
+        symbols[id] = (ObjectSymbol) {
+            .name = stringsLength,
+            .section = symbol->defined ? 0 : UNDEFINED_SECTION,
+            .value = symbol->defined ? symbol->address : 0
+        };
+        stringsLength += symbol->length + 1;
+    }
+
+    // Pad the string table to a whole number of words, so the section contents stay aligned.
+    size_t paddedLength = (stringsLength + 0x3) & ~(size_t) 0x3;
+    char *strings = calloc(paddedLength, 1);
+    assertFatal(strings != NULL, "<Memory> Unable to allocate object strings!");
+    for (size_t id = 0; id < state.symbolCount; id++) {
+        memcpy(strings + symbols[id].name, state.symbolTable[id].label, state.symbolTable[id].length);
+    }
+
+    ObjectHeader header = {
+        .magic = OBJECT_MAGIC, .version = OBJECT_VERSION, .sectionCount = 1, .symbolCount = state.symbolCount,
+        .relocationCount = relocationCount, .stringsLength = paddedLength
+    };
+    ObjectSection section = { .name = TEXT_SECTION, .size = state.irCount * sizeof(Instruction) };
+
+    writeAll(out, &header, sizeof(header));
+    writeAll(out, &section, sizeof(section));
+    writeAll(out, symbols, state.symbolCount * sizeof(ObjectSymbol));
+    writeAll(out, relocations, relocationCount * sizeof(ObjectRelocation));
+    writeAll(out, strings, paddedLength);
+    writeAll(out, text, section.size);
+
+    free(strings);
+    free(symbols);
+    free(relocations);
+    free(text);
+    destroyState(state);
+}
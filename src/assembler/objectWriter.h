@@ -0,0 +1,23 @@
+///
+/// objectWriter.h
+/// Assembles a source into a relocatable object, leaving references to labels it does not define to the linker.
+///
+
+#ifndef ASSEMBLER_OBJECT_WRITER_H
+#define ASSEMBLER_OBJECT_WRITER_H
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "assemblerDelegate.h"
+#include "const.h"
+#include "error.h"
+#include "helpers.h"
+#include "objectFormat.h"
+#include "state.h"
+#include "stream.h"
+
+void writeObject(const char *source, size_t length, int out);
+
+#endif // ASSEMBLER_OBJECT_WRITER_H
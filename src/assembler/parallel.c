@@ -0,0 +1,154 @@
+///
+/// parallel.c
+/// Two-pass assembly of a source split into chunks, each parsed and translated on its own thread.
+///
+
+#include "parallel.h"
+
+/// First pass over a [Chunk]: parses its lines into chunk-local IRs and labels.
+/// @param chunk The [Chunk] to parse.
+static void parseChunk(Chunk *chunk) {
+    const char *cursor = chunk->start;
+    while (cursor != chunk->end) {
+        cursor = parseLine(cursor, chunk->end, &chunk->state);
+    }
+}
+
+/// Second pass over a [Chunk]: translates its IRs against the merged symbol table.
+/// @param chunk The [Chunk] to translate.
+static void translateChunk(Chunk *chunk) {
+    // Share the merged symbol table read-only, but keep a private [address] for jump offset calculations.
+    AssemblerState state = *chunk->global;
+    state.address = chunk->base;
+
+    for (size_t i = 0; i < chunk->state.irCount; i++) {
+        IR *ir = &chunk->state.irList[i];
+
+        // Re-point chunk-local label references at the merged symbol table.
+        Literal *literal = getLabelLiteral(ir);
+        if (literal != NULL) {
+            size_t id = chunk->globalIds[literal->data.label.id];
+            literal->data.label = (struct Label) { .id = id, .name = state.symbolTable[id].label };
+        }
+
+        chunk->image[i] = getTranslator(&ir->type)(ir, &state);
+        state.address += 0x4;
+    }
+}
+
+/// Parses a [Chunk], waits for the labels of every chunk to be merged, then translates it, so that the same thread
+/// serves the chunk in both passes.
+/// @param arg The [Chunk] to assemble.
+/// @returns NULL.
+static void *assembleChunk(void *arg) {
+    Chunk *chunk = arg;
+    parseChunk(chunk);
+    pthread_barrier_wait(chunk->parsed);
+    pthread_barrier_wait(chunk->merged);
+    translateChunk(chunk);
+    return NULL;
+}
+
+/// Lays the parsed chunks out one after another, and merges their labels in source order, so that any duplicate is
+/// reported as in a sequential assembly.
+/// @param chunks The parsed [Chunk]s, whose [Chunk.base] and [Chunk.globalIds] are set.
+/// @param chunkCount The number of [chunks].
+/// @returns The state holding the merged symbol table, whose [address] is the size of the image.
+static AssemblerState mergeChunks(Chunk *chunks, size_t chunkCount) {
+    AssemblerState global = createState();
+    for (size_t i = 0; i < chunkCount; i++) {
+        Chunk *chunk = &chunks[i];
+        chunk->base = global.address;
+        global.address += chunk->state.irCount * sizeof(Instruction);
+
+        // A chunk without labels needs no mapping.
+        chunk->globalIds = NULL;
+        if (chunk->state.symbolCount == 0) continue;
+
+        chunk->globalIds = malloc(chunk->state.symbolCount * sizeof(size_t));
+        assertFatalNotNull(chunk->globalIds, "<Memory> Unable to allocate [globalIds]!");
+        for (size_t id = 0; id < chunk->state.symbolCount; id++) {
+            struct Symbol *symbol = &chunk->state.symbolTable[id];
+            chunk->globalIds[id] = symbol->defined
+                ? addMapping(&global, symbol->label, symbol->length, chunk->base + symbol->address)
+                : internLabel(&global, symbol->label, symbol->length);
+        }
+    }
+    return global;
+}
+
+/// Assembles [source] with up to [threads] threads.
+/// The source is split into chunks of whole lines, which are parsed in parallel with chunk-local labels. The chunks'
+/// base addresses are then a prefix sum of their sizes, and their labels are merged in source order, before the
+/// same threads translate the chunks straight into their place in the image.
+/// @param source The assembly source, which need not be null-terminated.
+/// @param length The number of characters in [source].
+/// @param threads The maximum number of threads to use.
+/// @param[out] count The number of [Instruction]s in the image.
+/// @returns The binary image, to be freed by the caller.
+Instruction *assembleParallel(const char *source, size_t length, long threads, size_t *count) {
+    // Small sources are not worth the threads.
+    size_t chunkCount = length / MIN_CHUNK_SIZE;
+    if (chunkCount > (size_t) threads) chunkCount = threads;
+    if (chunkCount == 0) chunkCount = 1;
+
+    // Every thread waits at [parsed] once its chunk is parsed, and at [merged] until the labels are merged.
+    pthread_barrier_t parsed, merged;
+    pthread_barrier_init(&parsed, NULL, chunkCount);
+    pthread_barrier_init(&merged, NULL, chunkCount);
+
+    Chunk *chunks = malloc(chunkCount * sizeof(Chunk));
+    assertFatalNotNull(chunks, "<Memory> Unable to allocate [chunks]!");
+    const char *cursor = source;
+    const char *end = source + length;
+    for (size_t i = 0; i < chunkCount; i++) {
+        // Cut after the first newline past an even share, so that no line is split.
+        const char *cut = i + 1 == chunkCount ? end : source + length / chunkCount * (i + 1);
+        if (cut < cursor) cut = cursor;
+        const char *newline = cut == end ? NULL : memchr(cut, '\n', end - cut);
+        cut = newline != NULL ? newline + 1 : end;
+
+        chunks[i] = (Chunk) {
+            .start = cursor, .end = cut, .state = createState(), .parsed = &parsed, .merged = &merged
+        };
+        cursor = cut;
+    }
+
+    pthread_t *workers = malloc(chunkCount * sizeof(pthread_t));
+    assertFatalNotNull(workers, "<Memory> Unable to allocate assembler threads!");
+
+    // The calling thread takes the first chunk itself, and merges the labels between the two passes.
+    for (size_t i = 1; i < chunkCount; i++) {
+        assertFatal(pthread_create(&workers[i], NULL, assembleChunk, &chunks[i]) == 0,
+                    "Unable to create assembler thread!");
+    }
+    parseChunk(&chunks[0]);
+    pthread_barrier_wait(&parsed);
+
+    AssemblerState global = mergeChunks(chunks, chunkCount);
+    *count = global.address / sizeof(Instruction);
+    Instruction *image = malloc(global.address);
+    assertFatalNotNull(image, "Unable to allocate output image!");
+    for (size_t i = 0; i < chunkCount; i++) {
+        chunks[i].global = &global;
+        chunks[i].image = image + chunks[i].base / sizeof(Instruction);
+    }
+
+    pthread_barrier_wait(&merged);
+    translateChunk(&chunks[0]);
+    for (size_t i = 1; i < chunkCount; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    free(workers);
+    pthread_barrier_destroy(&parsed);
+    pthread_barrier_destroy(&merged);
+
+    for (size_t i = 0; i < chunkCount; i++) {
+        free(chunks[i].globalIds);
+        destroyState(chunks[i].state);
+    }
+    free(chunks);
+    destroyState(global);
+
+    return image;
+}
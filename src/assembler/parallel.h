@@ -0,0 +1,57 @@
+///
+/// parallel.h
+/// Two-pass assembly of a source split into chunks, each parsed and translated on its own thread.
+///
+
+#ifndef ASSEMBLER_PARALLEL_H
+#define ASSEMBLER_PARALLEL_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "assemblerDelegate.h"
+#include "const.h"
+#include "error.h"
+#include "helpers.h"
+#include "state.h"
+
+/// The smallest chunk of source worth handing to a thread of its own.
+#define MIN_CHUNK_SIZE (256 * 1024)
+
+/// A contiguous run of whole lines of the source, assembled by one thread.
+typedef struct {
+
+    /// The first character of the chunk.
+    const char *start;
+
+    /// The end of the chunk, just past its last newline.
+    const char *end;
+
+    /// The chunk-local state, whose addresses and symbol IDs start from zero.
+    AssemblerState state;
+
+    /// The address of the chunk's first instruction in the whole program.
+    BitData base;
+
+    /// The global symbol ID of each chunk-local symbol ID.
+    size_t *globalIds;
+
+    /// The state holding the merged symbol table of the whole program.
+    const AssemblerState *global;
+
+    /// Where the chunk's translated instructions go, in the image of the whole program.
+    Instruction *image;
+
+    /// The barrier at which every thread waits once its chunk is parsed.
+    pthread_barrier_t *parsed;
+
+    /// The barrier at which every thread waits until the labels of every chunk are merged.
+    pthread_barrier_t *merged;
+
+} Chunk;
+
+Instruction *assembleParallel(const char *source, size_t length, long threads, size_t *count);
+
+#endif // ASSEMBLER_PARALLEL_H
@@ -33,15 +33,15 @@ static int branchCmp(const void *v1, const void *v2) {
 /// @param state The current state of the assembler.
 /// @returns The [IR] form of the branch instruction.
 /// @pre The [line]'s mnemonic is that of a branch instruction.
-IR parseBranch(TokenisedLine *line, unused AssemblerState *state) {
+IR parseBranch(TokenisedLine *line, AssemblerState *state) {
     assertFatal(line->operandCount == 1, "Incorrect number of operands; branch instructions need 1!");
     Branch_IR branchIR;
 
     if (!strcmp(line->mnemonic, "b")) {
         // Either branch unconditional or conditional
-        const Literal simm = parseLiteral(line->operands[0]);
+        const Literal simm = parseLiteralToken(line, 0, state);
 
-        if (line->subMnemonic == NULL) {
+        if (line->subMnemonic[0] == '\0') {
             // Branch unconditional
             branchIR = (Branch_IR) { .type = BRANCH_UNCONDITIONAL, .data.simm26 = simm };
         } else {
@@ -58,7 +58,7 @@ IR parseBranch(TokenisedLine *line, unused AssemblerState *state) {
         }
     } else if (!strcmp(line->mnemonic, "br")) {
         // Branch register
-        uint8_t xn = parseRegisterStr(line->operands[0], NULL);
+        uint8_t xn = parseRegisterToken(line, 0, NULL);
         branchIR = (Branch_IR) { .type = BRANCH_REGISTER, .data.xn = xn };
     } else {
         throwFatalWithArgs("Received invalid branch instruction <%s>!", line->mnemonic);
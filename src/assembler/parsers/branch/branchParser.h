@@ -19,12 +19,12 @@
 /// An entry in an [enum BranchCondition] table.
 typedef struct {
 
-    char *subMnemonic;
+    const char *subMnemonic;
 
     enum BranchCondition code;
 
 } BranchEntry;
 
-IR parseBranch(TokenisedLine *line, unused AssemblerState *state);
+IR parseBranch(TokenisedLine *line, AssemblerState *state);
 
 #endif // ASSEMBLER_BRANCH_PARSER_H
@@ -8,7 +8,6 @@
 #ifndef ASSEMBLER_DATA_PROCESSING_PARSER_H
 #define ASSEMBLER_DATA_PROCESSING_PARSER_H
 
-#include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -19,6 +18,8 @@
 #include "registerParser.h"
 #include "state.h"
 
-IR parseDataProcessing(TokenisedLine *line, unused AssemblerState *state);
+IR parseDataProcessing(TokenisedLine *line, AssemblerState *state);
+
+void expandAlias(TokenisedLine *line, const char *alias, int zeroIndex, int operandCount);
 
 #endif // ASSEMBLER_DATA_PROCESSING_PARSER_H
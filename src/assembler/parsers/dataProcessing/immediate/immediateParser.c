@@ -18,7 +18,7 @@ IR parseImmediate(TokenisedLine *line, unused AssemblerState *state) {
     Immediate_IR immediateIR;
 
     bool sf;
-    const uint8_t reg = parseRegisterStr(line->operands[0], &sf);
+    const uint8_t reg = parseRegisterToken(line, 0, &sf);
 
     if (*(line->mnemonic) == 'm') {
         enum WideMoveType type;
@@ -40,27 +40,22 @@ IR parseImmediate(TokenisedLine *line, unused AssemblerState *state) {
         }
 
         struct WideMove wideMove;
-        wideMove.imm16 = parseImmediateStr(line->operands[1], IMMEDIATE_WIDE_MOVE_IMM16_N);
+        wideMove.imm16 = parseImmediateToken(line, 1, IMMEDIATE_WIDE_MOVE_IMM16_N);
 
         // Get shift is <lsl> is present.
         wideMove.hw = 0x0;
         if (line->operandCount == 3) {
-            int matched;
-            char **shiftAndValue = split(line->operands[2], " ", &matched);
-            assertFatal(matched == 2, "Incorrect shift parameter!");
-            assertFatal(!strcmp(shiftAndValue[0], "lsl"), "Wide move received shift other than logical left!");
+            assertFatal(line->tokenCount == 4, "Incorrect shift parameter!");
+            assertFatal(expectToken(line, 2, TOKEN_SHIFT)->data.shift == LSL,
+                        "Wide move received shift other than logical left!");
 
             // The "hw" in assembly is actually 16 times the value in the binary instruction.
-            uint8_t hwTemp = parseImmediateStr(shiftAndValue[1], IMMEDIATE_WIDE_MOVE_HW_N + 4);
-            assertFatalWithArgs(hwTemp % 16 == 0, "Wide move shift <%s> is not a multiple of 16!", shiftAndValue[1]);
+            uint8_t hwTemp = parseImmediateToken(line, 3, IMMEDIATE_WIDE_MOVE_HW_N + 4);
+            assertFatalWithArgs(hwTemp % 16 == 0, "Wide move shift <%d> is not a multiple of 16!", hwTemp);
 
             // The maximum value [hw] can be is 0b11, i.e., 3. (3 * 16 = 48)
             assertFatal(hwTemp <= 48, "Wide move shift value is too high!");
             wideMove.hw = hwTemp / 16;
-
-            free(shiftAndValue[0]);
-            free(shiftAndValue[1]);
-            free(shiftAndValue);
         }
 
         immediateIR = (Immediate_IR) {
@@ -79,25 +74,20 @@ IR parseImmediate(TokenisedLine *line, unused AssemblerState *state) {
 
         struct Arithmetic arithmetic;
 
-        arithmetic.rn = parseRegisterStr(line->operands[1], &sf);
-        arithmetic.imm12 = parseImmediateStr(line->operands[2], IMMEDIATE_ARITHMETIC_IMM12_N);
+        arithmetic.rn = parseRegisterToken(line, 1, &sf);
+        arithmetic.imm12 = parseImmediateToken(line, 2, IMMEDIATE_ARITHMETIC_IMM12_N);
 
         // Get shift is <lsl> is present.
         arithmetic.sh = false;
         if (line->operandCount == 4) {
-            int matched;
-            char **shiftAndValue = split(line->operands[3], " ", &matched);
-            assertFatal(matched == 2, "Incorrect shift parameter!");
-            assertFatal(!strcmp(shiftAndValue[0], "lsl"), "Immediate arithmetic received shift other than logical left!");
+            assertFatal(line->tokenCount == 5, "Incorrect shift parameter!");
+            assertFatal(expectToken(line, 3, TOKEN_SHIFT)->data.shift == LSL,
+                        "Immediate arithmetic received shift other than logical left!");
 
             // The "hw" in assembly is actually 16 times the value in the binary instruction.
-            uint8_t shiftAmount = parseImmediateStr(shiftAndValue[1], IMMEDIATE_WIDE_MOVE_HW_N + 4);
+            uint8_t shiftAmount = parseImmediateToken(line, 4, IMMEDIATE_WIDE_MOVE_HW_N + 4);
             assertFatal(shiftAmount == 0 || shiftAmount == 0xC, "Arithmetic shift is not 0x0 or 0xC!");
             arithmetic.sh = shiftAmount == 0xC;
-
-            free(shiftAndValue[0]);
-            free(shiftAndValue[1]);
-            free(shiftAndValue);
         }
 
         immediateIR = (Immediate_IR) {
@@ -26,9 +26,9 @@ IR parseRegister(TokenisedLine *line, unused AssemblerState *state) {
 
     // Parse all registers, and ensure their bit-width is identical.
     bool sfRD, sfRN, sfRM;
-    registerIR.rd = parseRegisterStr(line->operands[0], &sfRD);
-    registerIR.rn = parseRegisterStr(line->operands[1], &sfRN);
-    registerIR.rm = parseRegisterStr(line->operands[2], &sfRM);
+    registerIR.rd = parseRegisterToken(line, 0, &sfRD);
+    registerIR.rn = parseRegisterToken(line, 1, &sfRN);
+    registerIR.rm = parseRegisterToken(line, 2, &sfRM);
     assertFatal(sfRD == sfRN && sfRN == sfRM, "Register bit-widths not identical!");
     registerIR.sf = sfRD;
 
@@ -74,7 +74,7 @@ IR parseRegister(TokenisedLine *line, unused AssemblerState *state) {
             registerIR.M = true;
             registerIR.opr = REGISTER_MULTIPLY_C;
 
-            uint8_t ra = parseRegisterStr(line->operands[3], NULL);
+            uint8_t ra = parseRegisterToken(line, 3, NULL);
             bool x = (registerIR.opc.multiply == MSUB);
             registerIR.operand = (union RegisterOperand) { .multiply = (struct Multiply) { x, ra }};
             break;
@@ -105,29 +105,10 @@ IR parseRegister(TokenisedLine *line, unused AssemblerState *state) {
     // Deal with shift, if present.
     // We know that if the last argument exists, it must be a shift.
     if (line->operandCount == 4 && registerIR.group != MULTIPLY) {
-        int numMatched;
-        char **shiftAndValue = split(line->operands[3], " ", &numMatched);
-        assertFatalWithArgs(numMatched == 2, "Incomplete shift parameter <%s>!", line->operands[3]);
+        assertFatal(line->tokenCount == 5, "Incomplete shift parameter!");
+        enum ShiftType shift = expectToken(line, 3, TOKEN_SHIFT)->data.shift;
 
-        enum ShiftType shift;
-        switch (shiftAndValue[0][0]) {
-            case 'l':
-                shift = (shiftAndValue[0][2] == 'l') ? LSL : LSR;
-                break;
-
-            case 'a':
-                shift = ASR;
-                break;
-
-            case 'r':
-                shift = ROR;
-                break;
-
-            default:
-                throwFatalWithArgs("Given shift <%s> was not a shift!", shiftAndValue[0]);
-        }
-
-        uint8_t imm6 = parseImmediateStr(shiftAndValue[1], REGISTER_OPERAND_IMM6_N);
+        uint8_t imm6 = parseImmediateToken(line, 4, REGISTER_OPERAND_IMM6_N);
         registerIR.operand.imm6 = imm6;
         registerIR.shift = shift;
     }
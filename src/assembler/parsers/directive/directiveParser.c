@@ -17,15 +17,7 @@ IR parseDirective(TokenisedLine *tokenisedLine, unused AssemblerState *state) {
                 "Incorrect number of operands; directives instructions need 1!");
 
     if (!strcmp(tokenisedLine->subMnemonic, "int")) {
-        // Reserve space for line, null terminator, and prepended '#'.
-        char *immediateStr = (char *) malloc(strlen(tokenisedLine->operands[0]) + 2);
-        assertFatalNotNull(immediateStr, "<Memory> Unable to allocate [char *]!");
-        *immediateStr = '#';
-        strcpy(immediateStr + 1, tokenisedLine->operands[0]);
-
-        // Very cheesy trick to reuse [parseImmediateStr].
-        BitData immediate = parseImmediateStr(immediateStr, 8 * sizeof(int32_t));
-        free(immediateStr);
+        BitData immediate = parseImmediateToken(tokenisedLine, 0, 8 * sizeof(int32_t));
         return (IR) { .type = DIRECTIVE, .ir.memoryData = immediate };
     } else {
         // We do not handle any other directives.
@@ -12,56 +12,52 @@
 /// @param state The current state of the assembler.
 /// @returns The [IR] form of the load/store instruction.
 /// @pre The [line]'s mnemonic is that of a load/store instruction.
-IR parseLoadStore(TokenisedLine *line, unused AssemblerState *state) {
+IR parseLoadStore(TokenisedLine *line, AssemblerState *state) {
     assertFatal(line->operandCount == 2 || line->operandCount == 3,
                 "Incorrect number of operands; load-store instructions need 2 or 3!");
     LoadStore_IR loadStoreIR;
 
     bool sf;
-    const uint8_t reg = parseRegisterStr(line->operands[0], &sf);
+    const uint8_t reg = parseRegisterToken(line, 0, &sf);
 
-    if (line->operands[1][0] == '[') {
+    if (hasToken(line, 1, TOKEN_OPEN_BRACKET)) {
         // Single data transfer
         bool u = false;
         enum AddressingMode mode;
         union Offset offset;
-        uint8_t xn;
-        assertFatal(sscanf(line->operands[1], "[%*c%" SCNu8, &xn) == 1,
-                    "Could not scan <xn>!");
-        if (line->operandCount == 2) {
-            // Zero Unsigned Offset
-            u = true;
-            mode = UNSIGNED_OFFSET;
-            offset.uoffset = 0;
+        const uint8_t xn = parseRegisterToken(line, 2, NULL);
+        if (hasToken(line, 3, TOKEN_CLOSE_BRACKET)) {
+            if (line->tokenCount == 4) {
+                // Zero Unsigned Offset
+                u = true;
+                mode = UNSIGNED_OFFSET;
+                offset.uoffset = 0;
+            } else {
+                // Post-Index
+                assertFatal(line->tokenCount == 5, "Incorrect post-index offset!");
+                mode = POST_INDEXED;
+                offset.prePostIndex.i = false;
+                offset.prePostIndex.simm9 = parseImmediateToken(line, 4, LOAD_STORE_DATA_SIMM9_INDEXED_N);
+            }
         } else {
-            char *lastOperand = line->operands[2];
-
-            switch (lastOperand[strlen(lastOperand) - 1]) {
-                case '!':
-                    // Pre-Index
-                    mode = PRE_INDEXED;
-                    offset.prePostIndex.i = true;
-                    offset.prePostIndex.simm9 = parseImmediateStr(line->operands[2], LOAD_STORE_DATA_SIMM9_INDEXED_N);
-                    break;
-
-                case ']':
-                    if (lastOperand[0] == '#') {
-                        // Unsigned Offset
-                        mode = UNSIGNED_OFFSET;
-                        u = true;
-                        offset.uoffset = parseImmediateStr(line->operands[2], LOAD_STORE_DATA_OFFSET_N);
-                    } else {
-                        //Register Offset
-                        mode = REGISTER_OFFSET;
-                        offset.xm = parseRegisterStr(line->operands[2], NULL);
-                    }
-                    break;
-
-                default:
-                    // Post-Index
-                    mode = POST_INDEXED;
-                    offset.prePostIndex.i = false;
-                    offset.prePostIndex.simm9 = parseImmediateStr(line->operands[2], LOAD_STORE_DATA_SIMM9_INDEXED_N);
+            expectToken(line, 4, TOKEN_CLOSE_BRACKET);
+            if (line->tokenCount == 6) {
+                // Pre-Index
+                expectToken(line, 5, TOKEN_EXCLAMATION);
+                mode = PRE_INDEXED;
+                offset.prePostIndex.i = true;
+                offset.prePostIndex.simm9 = parseImmediateToken(line, 3, LOAD_STORE_DATA_SIMM9_INDEXED_N);
+            } else if (hasToken(line, 3, TOKEN_IMMEDIATE)) {
+                // Unsigned Offset
+                assertFatal(line->tokenCount == 5, "Incorrect unsigned offset!");
+                mode = UNSIGNED_OFFSET;
+                u = true;
+                offset.uoffset = parseImmediateToken(line, 3, LOAD_STORE_DATA_OFFSET_N);
+            } else {
+                //Register Offset
+                assertFatal(line->tokenCount == 5, "Incorrect register offset!");
+                mode = REGISTER_OFFSET;
+                offset.xm = parseRegisterToken(line, 3, NULL);
             }
         }
 
@@ -79,7 +75,8 @@ IR parseLoadStore(TokenisedLine *line, unused AssemblerState *state) {
         };
     } else {
         // Load literal
-        const Literal literal = parseLiteral(line->operands[1]);
+        assertFatal(line->tokenCount == 2, "Incorrect load literal!");
+        const Literal literal = parseLiteralToken(line, 1, state);
         loadStoreIR = (LoadStore_IR) { sf, .type = LOAD_LITERAL, .data.simm19 = literal, .rt = reg };
     }
 
@@ -16,6 +16,6 @@
 #include "ir.h"
 #include "state.h"
 
-IR parseLoadStore(TokenisedLine *tokenisedLine, unused AssemblerState *state);
+IR parseLoadStore(TokenisedLine *tokenisedLine, AssemblerState *state);
 
 #endif // ASSEMBLER_LOAD_STORE_PARSER_H
@@ -0,0 +1,57 @@
+///
+/// systemParser.c
+/// Transform a [TokenisedLine] to an [IR] of a System instruction.
+///
+
+#include "systemParser.h"
+
+/// The mappings between system register names and their encodings.
+static const SystemRegisterEntry mappings[] = {
+    { "cntvct_el0",  CNTVCT_EL0 },
+    { "pmccntr_el0", PMCCNTR_EL0 },
+};
+
+/// Performs [strcasecmp] on the [name]s of [SystemRegisterEntry]s, but takes in [void *]s.
+/// @param v1 The first item.
+/// @param v2 The second item.
+/// @returns [int] of comparison.
+static int systemRegisterCmp(const void *v1, const void *v2) {
+    const SystemRegisterEntry *p1 = (const SystemRegisterEntry *) v1;
+    const SystemRegisterEntry *p2 = (const SystemRegisterEntry *) v2;
+    return strcasecmp(p1->name, p2->name);
+}
+
+/// Transform a [TokenisedLine] to an [IR] of a system instruction.
+/// @param line The [TokenisedLine] of the instruction.
+/// @param state The current state of the assembler.
+/// @returns The [IR] form of the system instruction.
+/// @pre The [line]'s mnemonic is that of a system instruction.
+IR parseSystem(TokenisedLine *line, unused AssemblerState *state) {
+    System_IR systemIR;
+
+    if (!strcmp(line->mnemonic, "hlt")) {
+        assertFatal(line->operandCount == 1, "Incorrect number of operands; halt instructions need 1!");
+        uint16_t imm16 = parseImmediateToken(line, 0, SYSTEM_HLT_IMM16_N);
+        systemIR = (System_IR) { .type = SYSTEM_HLT, .data.imm16 = imm16 };
+    } else if (!strcmp(line->mnemonic, "mrs")) {
+        assertFatal(line->operandCount == 2, "Incorrect number of operands; mrs instructions need 2!");
+        bool sf;
+        uint8_t rt = parseRegisterToken(line, 0, &sf);
+        assertFatal(sf, "System registers must be read into 64-bit registers!");
+
+        // System register names are case-insensitive, and all fit in [name].
+        const struct LabelToken *label = &expectToken(line, 1, TOKEN_LABEL)->data.label;
+        char name[16];
+        snprintf(name, sizeof(name), "%.*s", (int) label->length, label->start);
+        SystemRegisterEntry target = (SystemRegisterEntry) { name, .code = -1 }; // Throwaway target.
+        SystemRegisterEntry *sysreg = bsearch(&target, mappings, sizeof(mappings) / sizeof(SystemRegisterEntry),
+                                              sizeof(SystemRegisterEntry), systemRegisterCmp);
+        assertFatalNotNullWithArgs(sysreg, "Unsupported system register <%.*s>!", (int) label->length, label->start);
+
+        systemIR = (System_IR) { .type = SYSTEM_MRS, .data.mrs = { .sysreg = sysreg->code, .rt = rt } };
+    } else {
+        throwFatalWithArgs("Received invalid system instruction <%s>!", line->mnemonic);
+    }
+
+    return (IR) { .type = SYSTEM, .ir.systemIR = systemIR };
+}
@@ -0,0 +1,29 @@
+///
+/// systemParser.h
+/// Transform a [TokenisedLine] to an [IR] of a System instruction.
+///
+
+#ifndef ASSEMBLER_SYSTEM_PARSER_H
+#define ASSEMBLER_SYSTEM_PARSER_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "error.h"
+#include "helpers.h"
+#include "ir.h"
+#include "state.h"
+
+/// An entry in an [enum SystemRegister] table.
+typedef struct {
+
+    const char *name;
+
+    enum SystemRegister code;
+
+} SystemRegisterEntry;
+
+IR parseSystem(TokenisedLine *line, unused AssemblerState *state);
+
+#endif // ASSEMBLER_SYSTEM_PARSER_H
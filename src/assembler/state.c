@@ -12,110 +12,150 @@
 AssemblerState createState(void) {
     AssemblerState state;
     state.address = 0x0;
-    state.symbolTable = NULL;
+    state.arena = createArena();
 
     state.irList = calloc(INITIAL_LIST_SIZE, sizeof(IR));
     assertFatalNotNull(state.irList, "<Memory> Unable to contiguously allocate [irList]!");
     state.irCount = 0;
     state.irMaxCount = INITIAL_LIST_SIZE;
 
-    state.symbolTable = calloc(INITIAL_LIST_SIZE, sizeof(struct SymbolPair));
+    state.symbolTable = calloc(INITIAL_LIST_SIZE, sizeof(struct Symbol));
     assertFatalNotNull(state.symbolTable, "<Memory> Unable to contiguously allocate [symbolTable]!");
     state.symbolCount = 0;
     state.symbolMaxCount = INITIAL_LIST_SIZE;
-    return state;
-}
 
-/// If applicable, frees the string label in a [Literal].
-/// @param literal The literal to be freed.
-static void freeLiteral(Literal *literal) {
-    // By our convention, this simply means that the [Literal]
-    // was initialised as a label.
-    if (literal->isLabel) free(literal->data.label);
-}
+    state.symbolIndex = calloc(INITIAL_INDEX_SIZE, sizeof(size_t));
+    assertFatalNotNull(state.symbolIndex, "<Memory> Unable to contiguously allocate [symbolIndex]!");
+    state.symbolIndexSize = INITIAL_INDEX_SIZE;
 
-/// Frees pointers held in an IR
-/// @param ir IR within which to free pointers
-static void freeIR(IR *irObject) {
-    switch (irObject->type) {
-        case BRANCH: {
-            Branch_IR *branch = &irObject->ir.branchIR;
-            switch (branch->type) {
-                case BRANCH_UNCONDITIONAL:
-                    freeLiteral(&branch->data.simm26);
-                    break;
-
-                case BRANCH_CONDITIONAL:
-                    freeLiteral(&branch->data.conditional.simm19);
-                    break;
-
-                default:
-                    break;
-            }
-            break;
-        }
-
-        case LOAD_STORE:
-            if (irObject->ir.loadStoreIR.type == LOAD_LITERAL) {
-                if (irObject->ir.loadStoreIR.data.simm19.isLabel) {
-                    free(irObject->ir.loadStoreIR.data.simm19.data.label);
-                }
-            }
-
-        default:
-            break;
-    }
+    // Single-pass mode is opt-in; its lists grow from empty on first use.
+    state.singlePass = false;
+    state.image = NULL;
+    state.imageBase = 0;
+    state.imageCount = 0;
+    state.imageMaxCount = 0;
+    state.fixupList = NULL;
+    state.fixupCount = 0;
+    state.fixupUsed = 0;
+    state.fixupMaxCount = 0;
+    state.freeFixups = 0;
+    return state;
 }
 
 /// Destroys the given [AssemblerState]
 /// @param state The [AssemblerState] to be destroyed.
+/// @remark Label [Literal]s point into [arena], so [irList] holds nothing else to free.
 void destroyState(AssemblerState state) {
-    for (size_t i = 0; i < state.symbolCount; i++) {
-        free(state.symbolTable[i].label);
+    freeArena(&state.arena);
+    free(state.symbolTable);
+    free(state.symbolIndex);
+    free(state.irList);
+    free(state.image);
+    free(state.fixupList);
+}
+
+/// Hashes a label with 64-bit FNV-1a.
+/// @param label The name of the label.
+/// @param length The number of characters in [label].
+/// @returns The hash of [label].
+static uint64_t hashLabel(const char *label, size_t length) {
+    uint64_t hash = 0xcbf29ce484222325;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (uint8_t) label[i];
+        hash *= 0x100000001b3;
     }
+    return hash;
+}
 
-    free(state.symbolTable);
+/// Finds the slot in the symbol index where [label] is, or would be inserted.
+/// @param state The [AssemblerState] to search.
+/// @param label The name of the label.
+/// @param length The number of characters in [label].
+/// @param hash The hash of [label].
+/// @returns The slot for [label], which is empty if [label] is not interned.
+static size_t *findSlot(AssemblerState *state, const char *label, size_t length, uint64_t hash) {
+    size_t mask = state->symbolIndexSize - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        size_t *slot = &state->symbolIndex[i];
+        if (*slot == 0) return slot;
 
-    for (size_t i = 0; i < state.irCount; i++) {
-        freeIR(&state.irList[i]);
+        struct Symbol *symbol = &state->symbolTable[*slot - 1];
+        if (symbol->hash == hash && symbol->length == length && !memcmp(symbol->label, label, length)) return slot;
     }
+}
 
-    free(state.irList);
+/// Doubles the number of slots in the symbol index, re-inserting every symbol.
+/// @param state The [AssemblerState] to modify.
+static void growIndex(AssemblerState *state) {
+    free(state->symbolIndex);
+    state->symbolIndexSize *= 2;
+    state->symbolIndex = calloc(state->symbolIndexSize, sizeof(size_t));
+    assertFatalNotNull(state->symbolIndex, "<Memory> Unable to expand by re-allocate [symbolIndex]!");
+
+    // Labels are unique, so each symbol simply takes the first free slot from its hash.
+    size_t mask = state->symbolIndexSize - 1;
+    for (size_t id = 0; id < state->symbolCount; id++) {
+        size_t i = state->symbolTable[id].hash & mask;
+        while (state->symbolIndex[i] != 0) i = (i + 1) & mask;
+        state->symbolIndex[i] = id + 1;
+    }
 }
 
-/// Given an [AssemblerState], add another [LabelAddressPair] mapping to it.
+/// Given a [label], gets its symbol ID in the given [AssemblerState], adding it as undefined if new.
 /// @param state The [AssemblerState] to be modified.
-/// @param label The name of the label.
-/// @param address The address of the label.
-void addMapping(AssemblerState *state, char *label, BitData address) {
-    struct SymbolPair symbolPair;
-    symbolPair.address = address;
-    symbolPair.label = label;
+/// @param label The name of the label, which need not be null-terminated.
+/// @param length The number of characters in [label].
+/// @returns The symbol ID of [label].
+size_t internLabel(AssemblerState *state, const char *label, size_t length) {
+    uint64_t hash = hashLabel(label, length);
+    size_t *slot = findSlot(state, label, length, hash);
+    if (*slot != 0) return *slot - 1;
 
     if (state->symbolCount >= state->symbolMaxCount) {
         // Exponential (doubling) scaling policy.
-        state->symbolTable = realloc(state->symbolTable, state->symbolMaxCount * 2);
+        state->symbolMaxCount *= 2;
+        state->symbolTable = realloc(state->symbolTable, state->symbolMaxCount * sizeof(struct Symbol));
         assertFatalNotNull(state->symbolTable, "<Memory> Unable to expand by re-allocate [symbolTable]!");
     }
 
-    state->symbolTable[state->symbolCount++] = symbolPair;
+    const char *name = arenaStrndup(&state->arena, label, length);
+    size_t id = state->symbolCount++;
+    state->symbolTable[id] = (struct Symbol) {
+        .label = name, .length = length, .hash = hash, .address = 0x0, .defined = false, .fixups = 0
+    };
+    *slot = id + 1;
+
+    // Keep the index at most half full, so that probe sequences stay short.
+    if (2 * state->symbolCount > state->symbolIndexSize) growIndex(state);
+    return id;
 }
 
-/// Given a [label], searches for its address in the given [AssemblerState].
+/// Given an [AssemblerState], defines [label] to point to [address].
 /// @param state The [AssemblerState] to be modified.
-/// @param label The name of the label.
-/// @returns Either a pointer to the address, or NULL if not found.
-/// @attention We return a pointer simply to be able to express NULL as failure.
-BitData *getMapping(AssemblerState *state, const char *label) {
-    for (size_t i = 0; i < state->symbolCount; i++) {
-        if (!strcmp(state->symbolTable[i].label, label)) {
-            // Returning pointer to [uint32_t] is safe here
-            // since the value is not defined in this scope.
-            return &state->symbolTable[i].address;
-        }
-    }
+/// @param label The name of the label, which need not be null-terminated.
+/// @param length The number of characters in [label].
+/// @param address The address of the label.
+/// @returns The symbol ID of [label].
+size_t addMapping(AssemblerState *state, const char *label, size_t length, BitData address) {
+    // Intern first, as doing so may move [symbolTable].
+    size_t id = internLabel(state, label, length);
+    struct Symbol *symbol = &state->symbolTable[id];
+    assertFatalWithArgs(!symbol->defined, "Duplicate label named <%s>!", symbol->label);
+
+    symbol->address = address;
+    symbol->defined = true;
+    return id;
+}
 
-    return NULL;
+/// Given a symbol ID, searches for its address in the given [AssemblerState].
+/// @param state The [AssemblerState] to be searched.
+/// @param id The symbol ID of the label, from [internLabel].
+/// @returns Either a pointer to the address, or NULL if the label is not defined.
+/// @attention We return a pointer simply to be able to express NULL as failure.
+BitData *getMapping(AssemblerState *state, size_t id) {
+    assertFatal(id < state->symbolCount, "Invalid symbol ID!");
+    struct Symbol *symbol = &state->symbolTable[id];
+    return symbol->defined ? &symbol->address : NULL;
 }
 
 /// Adds an [IR] to the given [AssemblerState]
@@ -124,9 +164,93 @@ BitData *getMapping(AssemblerState *state, const char *label) {
 void addIR(AssemblerState *state, IR ir) {
     if (state->irCount >= state->irMaxCount) {
         // Exponential (doubling) scaling policy.
-        state->irList = realloc(state->irList, state->irMaxCount * 2);
+        state->irMaxCount *= 2;
+        state->irList = realloc(state->irList, state->irMaxCount * sizeof(IR));
         assertFatalNotNull(state->irList, "<Memory> Unable to expand by re-allocate [irList]!");
     }
 
     state->irList[state->irCount++] = ir;
 }
+
+/// Adds a translated [Instruction] to the [image] of the given [AssemblerState].
+/// @param state The [AssemblerState] to modify.
+/// @param instruction The [Instruction] to add.
+void addInstruction(AssemblerState *state, Instruction instruction) {
+    if (state->imageCount >= state->imageMaxCount) {
+        // Exponential (doubling) scaling policy.
+        state->imageMaxCount = state->imageMaxCount == 0 ? INITIAL_LIST_SIZE : 2 * state->imageMaxCount;
+        state->image = realloc(state->image, state->imageMaxCount * sizeof(Instruction));
+        assertFatalNotNull(state->image, "<Memory> Unable to expand by re-allocate [image]!");
+    }
+
+    state->image[state->imageCount++] = instruction;
+}
+
+/// Defers the translation of [ir], at the current address, until the label [id] is defined.
+/// @param state The [AssemblerState] to modify.
+/// @param id The symbol ID of the undefined label that [ir] references.
+/// @param ir The [IR] to translate later.
+void addFixup(AssemblerState *state, size_t id, IR ir) {
+    size_t index;
+    if (state->freeFixups != 0) {
+        // Reuse a resolved entry, so that [fixupList] only grows with the number of unresolved references.
+        index = state->freeFixups - 1;
+        state->freeFixups = state->fixupList[index].next;
+    } else {
+        index = state->fixupUsed++;
+        if (index >= state->fixupMaxCount) {
+            // Exponential (doubling) scaling policy.
+            state->fixupMaxCount = state->fixupMaxCount == 0 ? INITIAL_LIST_SIZE : 2 * state->fixupMaxCount;
+            state->fixupList = realloc(state->fixupList, state->fixupMaxCount * sizeof(struct Fixup));
+            assertFatalNotNull(state->fixupList, "<Memory> Unable to expand by re-allocate [fixupList]!");
+        }
+    }
+
+    struct Symbol *symbol = &state->symbolTable[id];
+    state->fixupList[index] = (struct Fixup) {
+        .ir = ir, .address = state->address, .next = symbol->fixups, .pending = true
+    };
+    symbol->fixups = index + 1;
+    state->fixupCount++;
+}
+
+/// Removes one of the instructions waiting on the label [id], if any.
+/// @param state The [AssemblerState] to modify.
+/// @param id The symbol ID of the label.
+/// @param[out] fixup The removed [Fixup].
+/// @returns Whether a [Fixup] was removed.
+bool takeFixup(AssemblerState *state, size_t id, struct Fixup *fixup) {
+    struct Symbol *symbol = &state->symbolTable[id];
+    if (symbol->fixups == 0) return false;
+
+    size_t index = symbol->fixups - 1;
+    *fixup = state->fixupList[index];
+    symbol->fixups = fixup->next;
+
+    state->fixupList[index].next = state->freeFixups;
+    state->fixupList[index].pending = false;
+    state->freeFixups = index + 1;
+    state->fixupCount--;
+    return true;
+}
+
+/// Counts the instructions at the start of [image] that are final, i.e., before the first one waiting on a label.
+/// @param state The [AssemblerState] to check.
+/// @returns The number of [Instruction]s at the start of [image] that can be written out.
+size_t getResolvedCount(AssemblerState *state) {
+    BitData first = (state->imageBase + state->imageCount) * sizeof(Instruction);
+    for (size_t i = 0; state->fixupCount > 0 && i < state->fixupUsed; i++) {
+        struct Fixup *fixup = &state->fixupList[i];
+        if (fixup->pending && fixup->address < first) first = fixup->address;
+    }
+    return first / sizeof(Instruction) - state->imageBase;
+}
+
+/// Drops the first [count] instructions of [image], once they have been written out.
+/// @param state The [AssemblerState] to modify.
+/// @param count The number of [Instruction]s to drop, which must all be resolved.
+void releaseImage(AssemblerState *state, size_t count) {
+    state->imageCount -= count;
+    state->imageBase += count;
+    memmove(state->image, state->image + count, state->imageCount * sizeof(Instruction));
+}
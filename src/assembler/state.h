@@ -8,38 +8,65 @@
 #ifndef ASSEMBLER_STATE_H
 #define ASSEMBLER_STATE_H
 
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "arena.h"
 #include "const.h"
 #include "error.h"
 #include "ir.h"
 
 #define INITIAL_LIST_SIZE 64
 
+/// The initial number of slots in the symbol index, kept at most half full.
+#define INITIAL_INDEX_SIZE 128
+
 /// Struct representing the current state of the assembler.
 typedef struct {
 
     /// The address of the current instruction being handled.
     BitData address;
 
-    /// The symbol table (label to address pairings).
-    struct SymbolPair {
+    /// Memory living as long as the assembly job, e.g., label names, released by [destroyState].
+    Arena arena;
+
+    /// The symbol table, indexed by symbol ID, holding every label defined or referenced.
+    struct Symbol {
+
+        /// The interned name of the label, held in [arena].
+        const char *label;
+
+        /// The number of characters in [label].
+        size_t length;
 
-        /// The address the label points to.
+        /// The hash of [label].
+        uint64_t hash;
+
+        /// The address the label points to, if [defined].
         BitData address;
 
-        /// The string title of the label.
-        char *label;
+        /// Whether the label has been defined yet.
+        bool defined;
+
+        /// The head of the chain of [fixupList] entries waiting on this label, as index + 1, or 0 if none.
+        size_t fixups;
 
     } *symbolTable;
 
-    /// The number of [SymbolPair]s in [symbolTable].
+    /// The number of [Symbol]s in [symbolTable].
     size_t symbolCount;
 
-    /// The maximum number of [SymbolPair]s that [symbolTable] is currently allocated for.
+    /// The maximum number of [Symbol]s that [symbolTable] is currently allocated for.
     size_t symbolMaxCount;
 
+    /// Open-addressing hash index over [symbolTable], holding symbol ID + 1 per slot, or 0 if the slot is empty.
+    size_t *symbolIndex;
+
+    /// The number of slots in [symbolIndex], always a power of two.
+    size_t symbolIndexSize;
+
     /// The list of all parsed intermediate representations.
     IR *irList;
 
@@ -49,16 +76,72 @@ typedef struct {
     /// The maximum number of [IR]s that [irList] is currently allocated for.
     size_t irMaxCount;
 
+    /// Whether instructions are translated into [image] as soon as they are parsed, instead of kept in [irList].
+    bool singlePass;
+
+    /// The binary instructions translated so far, in single-pass mode, from the one at [imageBase].
+    Instruction *image;
+
+    /// The number of instructions before [image], already written out and released by [releaseImage].
+    size_t imageBase;
+
+    /// The number of [Instruction]s in [image].
+    size_t imageCount;
+
+    /// The maximum number of [Instruction]s that [image] is currently allocated for.
+    size_t imageMaxCount;
+
+    /// Instructions waiting on a label not yet defined, in single-pass mode, chained per label from [Symbol.fixups].
+    struct Fixup {
+
+        /// The [IR] of the instruction, still to be translated.
+        IR ir;
+
+        /// The address of the instruction.
+        BitData address;
+
+        /// The next entry in the same chain, as index + 1, or 0 if none.
+        size_t next;
+
+        /// Whether the entry is still waiting on its label, rather than free for reuse.
+        bool pending;
+
+    } *fixupList;
+
+    /// The number of entries of [fixupList] still waiting on a label.
+    size_t fixupCount;
+
+    /// The number of entries of [fixupList] ever used, pending or free.
+    size_t fixupUsed;
+
+    /// The maximum number of [Fixup]s that [fixupList] is currently allocated for.
+    size_t fixupMaxCount;
+
+    /// The head of the chain of resolved [fixupList] entries free for reuse, as index + 1, or 0 if none.
+    size_t freeFixups;
+
 } AssemblerState;
 
 AssemblerState createState(void);
 
 void destroyState(AssemblerState state);
 
-void addMapping(AssemblerState *state, char *label, BitData address);
+size_t internLabel(AssemblerState *state, const char *label, size_t length);
+
+size_t addMapping(AssemblerState *state, const char *label, size_t length, BitData address);
 
-BitData *getMapping(AssemblerState *state, const char *label);
+BitData *getMapping(AssemblerState *state, size_t id);
 
 void addIR(AssemblerState *state, IR ir);
 
+void addInstruction(AssemblerState *state, Instruction instruction);
+
+void addFixup(AssemblerState *state, size_t id, IR ir);
+
+bool takeFixup(AssemblerState *state, size_t id, struct Fixup *fixup);
+
+size_t getResolvedCount(AssemblerState *state);
+
+void releaseImage(AssemblerState *state, size_t count);
+
 #endif // ASSEMBLER_STATE_H
@@ -0,0 +1,83 @@
+///
+/// stream.c
+/// Single-pass assembly from one file descriptor to another, e.g., a pipe, in bounded memory.
+///
+
+#include "stream.h"
+
+/// Writes all of [length] bytes of [buffer] to [fd].
+/// @param fd The file descriptor to write to.
+/// @param buffer The bytes to write.
+/// @param length The number of bytes in [buffer].
+void writeAll(int fd, const void *buffer, size_t length) {
+    // [write] may return early on large buffers and pipes, so keep going until everything is out.
+    const char *cursor = buffer;
+    while (length > 0) {
+        ssize_t written = write(fd, cursor, length);
+        assertFatal(written > 0, "Unable to write output!");
+        cursor += written;
+        length -= written;
+    }
+}
+
+/// Writes out the instructions of [state] that are final, and releases them.
+/// @param state The [AssemblerState] to flush.
+/// @param out The file descriptor to write to.
+static void flushImage(AssemblerState *state, int out) {
+    size_t count = getResolvedCount(state);
+    if (count == 0) return;
+
+    writeAll(out, state->image, count * sizeof(Instruction));
+    releaseImage(state, count);
+}
+
+/// Assembles the source read from [in] in a single pass, writing each instruction to [out] once it is final.
+/// Only whole lines are lexed, so the source is held one block at a time. Instructions are held back only from the
+/// first one waiting on a label not yet defined, so memory scales with the reach of forward references.
+/// @param in The file descriptor to read the source from.
+/// @param out The file descriptor to write the binary to.
+void assembleStream(int in, int out) {
+    AssemblerState state = createState();
+    state.singlePass = true;
+
+    size_t capacity = STREAM_BLOCK_SIZE;
+    size_t filled = 0;
+    char *buffer = malloc(capacity);
+    assertFatalNotNull(buffer, "<Memory> Unable to allocate source buffer!");
+
+    ssize_t bytes;
+    do {
+        // Only a line longer than the buffer makes it grow.
+        if (filled == capacity) {
+            capacity *= 2;
+            buffer = realloc(buffer, capacity);
+            assertFatalNotNull(buffer, "<Memory> Unable to expand by re-allocate source buffer!");
+        }
+
+        bytes = read(in, buffer + filled, capacity - filled);
+        assertFatal(bytes >= 0, "Unable to read source!");
+        filled += bytes;
+
+        // Lex up to the last newline, keeping any partial line for the next read, unless the source has ended.
+        const char *end = buffer + filled;
+        if (bytes > 0) {
+            const char *newline = memrchr(buffer, '\n', filled);
+            end = newline != NULL ? newline + 1 : buffer;
+        }
+
+        const char *cursor = buffer;
+        while (cursor != end) {
+            cursor = parseLine(cursor, end, &state);
+        }
+
+        filled -= end - buffer;
+        memmove(buffer, end, filled);
+        flushImage(&state, out);
+    } while (bytes > 0);
+
+    assertResolved(&state);
+    flushImage(&state, out);
+
+    free(buffer);
+    destroyState(state);
+}
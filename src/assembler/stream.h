@@ -0,0 +1,26 @@
+///
+/// stream.h
+/// Single-pass assembly from one file descriptor to another, e.g., a pipe, in bounded memory.
+///
+
+#ifndef ASSEMBLER_STREAM_H
+#define ASSEMBLER_STREAM_H
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "assemblerDelegate.h"
+#include "const.h"
+#include "error.h"
+#include "state.h"
+
+/// The number of bytes of source read at a time. The buffer grows beyond this only for longer lines.
+#define STREAM_BLOCK_SIZE (64 * 1024)
+
+void writeAll(int fd, const void *buffer, size_t length);
+
+void assembleStream(int in, int out);
+
+#endif // ASSEMBLER_STREAM_H
@@ -0,0 +1,31 @@
+///
+/// systemTranslator.c
+/// Transform a [IR] of a System instruction to a binary instruction.
+///
+
+#include "systemTranslator.h"
+
+/// Converts the IR form of a system instruction to a binary word.
+/// @param irObject The [IR] struct representing the instruction.
+/// @param state The current state of the assembler.
+/// @returns 32-bit binary word of the instruction.
+Instruction translateSystem(IR *irObject, unused AssemblerState *state) {
+    assertFatal(irObject->type == SYSTEM, "Received non-system IR!");
+    System_IR *systemIR = &irObject->ir.systemIR;
+    Instruction result;
+
+    switch (systemIR->type) {
+        case SYSTEM_HLT:
+            result = SYSTEM_HLT_B;
+            result |= (Instruction) truncater(systemIR->data.imm16, SYSTEM_HLT_IMM16_N) << SYSTEM_HLT_IMM16_S;
+            break;
+
+        case SYSTEM_MRS:
+            result = SYSTEM_MRS_B;
+            result |= (Instruction) truncater(systemIR->data.mrs.sysreg, SYSTEM_MRS_SYSREG_N) << SYSTEM_MRS_SYSREG_S;
+            result |= truncater(systemIR->data.mrs.rt, SYSTEM_MRS_RT_N);
+            break;
+    }
+
+    return result;
+}
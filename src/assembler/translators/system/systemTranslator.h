@@ -0,0 +1,16 @@
+///
+/// systemTranslator.h
+/// Transform a [IR] of a System instruction to a binary instruction.
+///
+
+#ifndef ASSEMBLER_SYSTEM_TRANSLATOR_H
+#define ASSEMBLER_SYSTEM_TRANSLATOR_H
+
+#include "const.h"
+#include "error.h"
+#include "ir.h"
+#include "state.h"
+
+Instruction translateSystem(IR *irObject, unused AssemblerState *state);
+
+#endif // ASSEMBLER_SYSTEM_TRANSLATOR_H
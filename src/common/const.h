@@ -42,6 +42,9 @@
 /// ID of the colour scheme for inverted errored content.
 #define I_ERROR_SCHEME   12
 
+/// ID of the colour scheme for the line numbers of breakpoints.
+#define BREAKPOINT_SCHEME 13
+
 /// The height (in characters) of GRIM's title.
 #define TITLE_HEIGHT      1
 
@@ -74,6 +77,7 @@ typedef enum {
 typedef enum {
     READ_ONLY, ///< File is read-only.
     UNSAVED,   ///< File has unsaved changes.
+    SAVING,    ///< File is being saved in the background, with no changes since.
     SAVED      ///< File has no pending changes.
 } EditorStatus;
 
@@ -13,6 +13,7 @@
 #include "register.h"
 #include "loadStore.h"
 #include "branch.h"
+#include "system.h"
 
 /// The type of [IR] represented.
 typedef enum {
@@ -30,7 +31,10 @@ typedef enum {
     BRANCH,
 
     /// Direct to memory constant.
-    DIRECTIVE
+    DIRECTIVE,
+
+    /// System.
+    SYSTEM
 
 } IRType;
 
@@ -55,6 +59,9 @@ typedef struct {
         /// Branch IR.
         Branch_IR branchIR;
 
+        /// System IR.
+        System_IR systemIR;
+
         /// Data (used by directives) IR.
         BitData memoryData;
 
@@ -0,0 +1,103 @@
+///
+/// system.h
+/// The intermediate representation of a system instruction.
+///
+
+#ifndef IR_SYSTEM_H
+#define IR_SYSTEM_H
+
+#include <stdint.h>
+
+#include "const.h"
+
+/// Baseline code for a system or exception generating instruction.
+#define SYSTEM_B          b(1101_0100_0000_0000_0000_0000_0000_0000)
+
+/// Mask for a system or exception generating instruction.
+#define SYSTEM_M          maskl(7)
+
+/// Baseline code for a halt instruction.
+#define SYSTEM_HLT_B      b(1101_0100_0100_0000_0000_0000_0000_0000)
+
+/// Mask for a halt instruction.
+#define SYSTEM_HLT_M      ((maskl(11)) | (maskr(5)))
+
+/// Number of bits to shift for [imm16] in a halt instruction.
+#define SYSTEM_HLT_IMM16_S 5
+
+/// Number of bits in [imm16] in a halt instruction.
+#define SYSTEM_HLT_IMM16_N 16
+
+/// Mask for [imm16] in a halt instruction.
+#define SYSTEM_HLT_IMM16_M mask(20, 5)
+
+/// Baseline code for a move from system register instruction.
+#define SYSTEM_MRS_B      b(1101_0101_0011_0000_0000_0000_0000_0000)
+
+/// Mask for a move from system register instruction.
+#define SYSTEM_MRS_M      maskl(12)
+
+/// Number of bits to shift for [sysreg] in a move from system register instruction.
+#define SYSTEM_MRS_SYSREG_S 5
+
+/// Number of bits in [sysreg] in a move from system register instruction.
+#define SYSTEM_MRS_SYSREG_N 15
+
+/// Mask for [sysreg] in a move from system register instruction.
+#define SYSTEM_MRS_SYSREG_M mask(19, 5)
+
+/// Number of bits in [rt] in a move from system register instruction.
+#define SYSTEM_MRS_RT_N   5
+
+/// Mask for [rt] in a move from system register instruction.
+#define SYSTEM_MRS_RT_M   maskr(5)
+
+/// The [imm16] of the halt instruction reserved for semihosting requests.
+#define SEMIHOSTING_HLT   0xF000
+
+/// The intermediate representation of a system instruction.
+typedef struct {
+
+    /// The type of system instruction.
+    enum SystemType {
+
+        /// Halt: stop for an external debugger, which serves semihosting requests.
+        SYSTEM_HLT,
+
+        /// Move from system register: read [sysreg] into [rt].
+        /// \code Xt := sysreg \endcode
+        SYSTEM_MRS,
+
+    } type;
+
+    /// The constants for the system instruction.
+    union System {
+
+        /// [16b] The halt number, passed on to the debugger.
+        uint16_t imm16;
+
+        /// Move from system register.
+        struct Mrs {
+
+            /// [15b] The system register to read, as its o0:op1:CRn:CRm:op2 encoding.
+            /// @attention Ordinal values represent binary encodings.
+            enum SystemRegister {
+
+                /// Performance monitors cycle count register: the virtual cycle count.
+                PMCCNTR_EL0 = 0x5CE8,
+
+                /// Counter-timer virtual count register: the retired instruction count.
+                CNTVCT_EL0 = 0x5F02,
+
+            } sysreg;
+
+            /// [5b] The encoding of the Rt register.
+            uint8_t rt;
+
+        } mrs;
+
+    } data;
+
+} System_IR;
+
+#endif // IR_SYSTEM_H
@@ -9,6 +9,7 @@
 #define IR_TYPES_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /// Literal IR.
@@ -20,8 +21,16 @@ typedef struct {
     /// The contents.
     union LiteralData {
 
-        /// The string label.
-        char *label;
+        /// The label, interned in the assembler's symbol table.
+        struct Label {
+
+            /// The symbol ID of the label.
+            size_t id;
+
+            /// The name of the label, owned by the symbol table.
+            const char *name;
+
+        } label;
 
         /// The signed immediate value.
         int32_t immediate;
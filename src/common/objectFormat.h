@@ -0,0 +1,117 @@
+///
+/// objectFormat.h
+/// The layout of relocatable object files, written by the assembler and combined by the linker.
+///
+
+#ifndef COMMON_OBJECT_FORMAT_H
+#define COMMON_OBJECT_FORMAT_H
+
+#include <stdint.h>
+
+#include "branch.h"
+#include "const.h"
+#include "loadStore.h"
+
+/// The word at the start of every object file, <AOBJ> in little-endian order.
+#define OBJECT_MAGIC        0x4A424F41
+
+/// The version of the object format, bumped whenever its layout changes.
+#define OBJECT_VERSION      1
+
+/// The [ObjectSymbol.section] of a symbol which an object refers to, but does not define.
+#define UNDEFINED_SECTION   UINT32_MAX
+
+/// The maximum number of characters in a section name, including the null terminator.
+#define SECTION_NAME_LENGTH 16
+
+/// The name of the section holding the instructions and data of an assembly source.
+#define TEXT_SECTION        ".text"
+
+/// The header at the start of an object file. It is followed by the [ObjectSection]s, [ObjectSymbol]s and
+/// [ObjectRelocation]s, then the string table, then the contents of each section in order.
+/// Every part is a whole number of words long, so each starts word-aligned.
+typedef struct {
+    /// Always [OBJECT_MAGIC].
+    uint32_t magic;
+
+    /// Always [OBJECT_VERSION].
+    uint32_t version;
+
+    /// The number of [ObjectSection]s.
+    uint32_t sectionCount;
+
+    /// The number of [ObjectSymbol]s.
+    uint32_t symbolCount;
+
+    /// The number of [ObjectRelocation]s.
+    uint32_t relocationCount;
+
+    /// The number of bytes in the string table, padded to a whole number of words.
+    uint32_t stringsLength;
+} ObjectHeader;
+
+/// A named, contiguous run of words, placed by the linker alongside the sections of the same name in other objects.
+typedef struct {
+    /// The null-terminated name of the section.
+    char name[SECTION_NAME_LENGTH];
+
+    /// The number of bytes in the section, a multiple of four.
+    uint32_t size;
+} ObjectSection;
+
+/// A label defined or referred to by an object.
+typedef struct {
+    /// The offset of the null-terminated name of the label in the string table.
+    uint32_t name;
+
+    /// The index of the section defining the label, or [UNDEFINED_SECTION].
+    uint32_t section;
+
+    /// The offset of the label in its section, if it is defined.
+    uint32_t value;
+} ObjectSymbol;
+
+/// The field of an instruction which a [ObjectRelocation] fills in with the word offset to its symbol.
+typedef enum {
+    /// The [simm26] of an unconditional branch.
+    RELOCATION_BRANCH26,
+
+    /// The [simm19] of a conditional branch.
+    RELOCATION_CONDITIONAL19,
+
+    /// The [simm19] of a load literal.
+    RELOCATION_LITERAL19,
+} RelocationType;
+
+/// An instruction which refers to a label the object does not define, to be filled in once it is placed.
+typedef struct {
+    /// The index of the section holding the instruction.
+    uint32_t section;
+
+    /// The offset of the instruction in its section.
+    uint32_t offset;
+
+    /// The index of the [ObjectSymbol] the instruction refers to.
+    uint32_t symbol;
+
+    /// The [RelocationType] of the field to fill in.
+    uint32_t type;
+} ObjectRelocation;
+
+/// The position of the field filled in by a [RelocationType].
+typedef struct {
+    /// The number of bits to shift the field by.
+    uint8_t shift;
+
+    /// The number of bits in the field.
+    uint8_t width;
+} RelocationField;
+
+/// The [RelocationField] of each [RelocationType], indexed by the type.
+static const RelocationField relocationFields[] = {
+    [RELOCATION_BRANCH26]      = { 0, BRANCH_UNCONDITIONAL_SIMM26_N },
+    [RELOCATION_CONDITIONAL19] = { BRANCH_CONDITIONAL_SIMM19_S, BRANCH_CONDITIONAL_SIMM19_N },
+    [RELOCATION_LITERAL19]     = { LOAD_STORE_LITERAL_SIMM19_S, LOAD_STORE_LITERAL_SIMM19_N },
+};
+
+#endif // COMMON_OBJECT_FORMAT_H
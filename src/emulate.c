@@ -9,13 +9,38 @@
 
 int main(int argc, char **argv) {
 
-    // Check that [argv] is valid, i.e., has 2-3 args.
-    if (argc < 2 || argc > 3) return EXIT_FAILURE;
+    // With -w, writes to the given range of memory are reported, as <address> or <address:length> in bytes.
+    size_t watchAddresses[MAX_WATCHPOINTS], watchLengths[MAX_WATCHPOINTS];
+    size_t watchCount = 0;
+    int option;
+    while ((option = getopt(argc, argv, "w:")) != -1) {
+        if (option == 'w' && watchCount < MAX_WATCHPOINTS
+            && parseWatchpoint(optarg, &watchAddresses[watchCount], &watchLengths[watchCount])) {
+            watchCount++;
+            continue;
+        }
+        fprintf(stderr, "Usage: ./emulate [-w address[:length]]... code.bin [out.txt]\n");
+        return EXIT_FAILURE;
+    }
+
+    // Check that [argv] is valid, i.e., has 1-2 args after the options.
+    if (argc - optind < 1 || argc - optind > 2) return EXIT_FAILURE;
 
     // Initialise registers and memory.
     Registers_s registersStruct = createRegs();
     Registers registers = &registersStruct;
-    Memory memory = allocMemFromFile(argv[1]);
+    Memory memory = allocMemFromFile(argv[optind]);
+
+    for (size_t i = 0; i < watchCount; i++) {
+        addWatchpoint(memory, watchAddresses[i], watchLengths[i]);
+    }
+
+    // Attach the Raspberry Pi peripherals. GPIO changes are logged to [stderr], keeping [stdout]
+    // for the guest's console and the dump. Console output must not be lost on fatal errors.
+    attachGPIO(stderr);
+    attachTimer();
+    attachUART(stdout);
+    atexit(flushUART);
 
     // Fetch first instruction
     Instruction instruction = readMem(memory, false, getRegPC(registers));
@@ -23,17 +48,29 @@ int main(int argc, char **argv) {
     // Fetch, decode, execute cycle while the program has not terminated
     while (instruction != HALT) {
         execute(&instruction, registers, memory);
+
+        WatchpointHit hit;
+        if (takeWatchpointHit(&hit)) {
+            char message[128];
+            formatWatchpointHit(&hit, message, sizeof(message));
+            fprintf(stderr, "%s\n", message);
+        }
     }
 
+    // Write out any console output still buffered, so that it precedes the dump.
+    flushUART();
+
     // Dump contents of register and memory, then free memory.
     FILE *fileOut = stdout;
-    if (argc == 3) fileOut = fopen(argv[2], "w");
+    if (argc - optind == 2) fileOut = fopen(argv[optind + 1], "w");
 
     dumpRegs(registers, fileOut);
     dumpMem(memory, fileOut);
+    clearWatchpoints();
     freeMem(memory);
 
     fclose(fileOut);
 
-    return EXIT_SUCCESS;
+    // A guest that exited through semihosting chooses the exit status.
+    return hasExited() ? getExitStatus() : EXIT_SUCCESS;
 }
@@ -9,14 +9,17 @@
 #define EMULATE_H
 
 #include <stdlib.h>
+#include <unistd.h>
 
 #include "emulatorDelegate.h"
+#include "gpioDevice.h"
+#include "timerDevice.h"
+#include "uartDevice.h"
 #include "ir.h"
 #include "memory.h"
 #include "output.h"
 #include "registers.h"
-
-#define HALT 0x8a000000
+#include "watchpoint.h"
 
 bool JUMP_ON_ERROR = false;
 jmp_buf fatalBuffer;
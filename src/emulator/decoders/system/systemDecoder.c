@@ -0,0 +1,37 @@
+///
+/// systemDecoder.c
+/// Decodes a binary word of a system instruction to its [IR].
+///
+
+#include "systemDecoder.h"
+
+/// Decodes a binary word of a system instruction to its [IR].
+/// @param word The [Instruction] to decode.
+/// @returns The [IR] of word.
+IR decodeSystem(Instruction word) {
+    System_IR systemIR;
+
+    if ((word & SYSTEM_HLT_M) == SYSTEM_HLT_B) {
+        systemIR = (System_IR) { .type = SYSTEM_HLT, .data.imm16 = decompose(word, SYSTEM_HLT_IMM16_M) };
+    } else if ((word & SYSTEM_MRS_M) == SYSTEM_MRS_B) {
+        // Only the counters are readable; no other system state is modelled.
+        uint16_t sysreg = decompose(word, SYSTEM_MRS_SYSREG_M);
+        switch (sysreg) {
+            case PMCCNTR_EL0:
+            case CNTVCT_EL0:
+                break;
+
+            default:
+                throwFatalWithArgs("Unsupported system register <0x%04x>!", sysreg);
+        }
+
+        systemIR = (System_IR) {
+            .type = SYSTEM_MRS,
+            .data.mrs = { .sysreg = sysreg, .rt = decompose(word, SYSTEM_MRS_RT_M) }
+        };
+    } else {
+        throwFatal("Invalid instruction format!");
+    }
+
+    return (IR) { .type = SYSTEM, .ir.systemIR = systemIR };
+}
@@ -0,0 +1,15 @@
+///
+/// systemDecoder.h
+/// Decodes a binary word of a system instruction to its [IR].
+///
+
+#ifndef EMULATOR_SYSTEM_DECODER_H
+#define EMULATOR_SYSTEM_DECODER_H
+
+#include "const.h"
+#include "error.h"
+#include "ir.h"
+
+IR decodeSystem(Instruction word);
+
+#endif // EMULATOR_SYSTEM_DECODER_H
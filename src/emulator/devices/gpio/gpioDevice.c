@@ -0,0 +1,100 @@
+///
+/// gpioDevice.c
+/// A stand-in for the Raspberry Pi's GPIO controller, logging pin changes.
+///
+
+#include "gpioDevice.h"
+
+/// The state of the GPIO controller.
+typedef struct {
+
+    /// The function select registers, GPFSEL0 to GPFSEL5.
+    uint32_t fsel[(GPIO_PINS + 9) / 10];
+
+    /// The current level of every pin, one bit per pin.
+    uint64_t level;
+
+    /// Where pin changes are logged to, or NULL to not log.
+    FILE *log;
+
+} GPIO;
+
+/// The single GPIO controller of the machine.
+static GPIO gpio;
+
+/// Determines whether [pin] is currently configured as an output.
+/// @param pin The pin number.
+/// @returns Whether the pin is an output.
+static bool isOutput(int pin) {
+    return ((gpio.fsel[pin / 10] >> (pin % 10) * 3) & maskr(3)) == GPIO_FSEL_OUT;
+}
+
+/// Drives the output pins selected by [pins] to [level], logging any that change.
+/// @param pins The pins to drive, one bit per pin.
+/// @param level Whether to drive the pins high.
+static void drivePins(uint64_t pins, bool level) {
+    for (int pin = 0; pin < GPIO_PINS; pin++) {
+        if (!(pins >> pin & 1) || !isOutput(pin)) continue;
+        if ((bool) (gpio.level >> pin & 1) == level) continue;
+
+        gpio.level ^= (uint64_t) 1 << pin;
+        if (gpio.log != NULL) {
+            fprintf(gpio.log, "[%" PRIu64 "] GPIO%02d: %s\n", getClock(), pin, level ? "HIGH" : "LOW");
+        }
+    }
+}
+
+/// Handles a read from a GPIO register.
+/// @param device Unused; there is only one controller.
+/// @param offset The offset of the register within the controller.
+/// @param as64 Whether to read 64 or 32 bits.
+/// @returns The register's contents.
+static BitData readGPIO(unused void *device, size_t offset, bool as64) {
+    assertFatal(!as64, "<GPIO> Registers must be accessed with 32-bit reads!");
+    assertFatalWithArgs(offset % sizeof(uint32_t) == 0, "<GPIO> Received unaligned read at offset 0x%zx!", offset);
+
+    uint32_t value;
+    if (offset <= GPIO_GPFSEL5) {
+        value = gpio.fsel[offset / sizeof(uint32_t)];
+    } else if (offset == GPIO_GPLEV0 || offset == GPIO_GPLEV0 + sizeof(uint32_t)) {
+        value = gpio.level >> (offset - GPIO_GPLEV0) * 8;
+    } else {
+        // Set and clear registers are write-only, as are the reserved words.
+        value = 0;
+    }
+    return value;
+}
+
+/// Handles a write to a GPIO register.
+/// @param device Unused; there is only one controller.
+/// @param offset The offset of the register within the controller.
+/// @param as64 Whether to write 64 or 32 bits.
+/// @param value The value written.
+static void writeGPIO(unused void *device, size_t offset, bool as64, BitData value) {
+    assertFatal(!as64, "<GPIO> Registers must be accessed with 32-bit writes!");
+    assertFatalWithArgs(offset % sizeof(uint32_t) == 0, "<GPIO> Received unaligned write at offset 0x%zx!", offset);
+    uint32_t word = value;
+
+    if (offset <= GPIO_GPFSEL5) {
+        gpio.fsel[offset / sizeof(uint32_t)] = word;
+    } else if (offset == GPIO_GPSET0 || offset == GPIO_GPSET0 + sizeof(uint32_t)) {
+        drivePins((uint64_t) word << (offset - GPIO_GPSET0) * 8, true);
+    } else if (offset == GPIO_GPCLR0 || offset == GPIO_GPCLR0 + sizeof(uint32_t)) {
+        drivePins((uint64_t) word << (offset - GPIO_GPCLR0) * 8, false);
+    }
+    // Writes to any other register are ignored.
+}
+
+/// Resets the GPIO controller and maps it into the physical address space.
+/// @param log Where to log pin changes to, or NULL to not log.
+void attachGPIO(FILE *log) {
+    gpio = (GPIO) { .log = log };
+    mapRegion((MMIORegion) {
+        .name = "GPIO",
+        .base = GPIO_BASE,
+        .size = GPIO_SIZE,
+        .device = &gpio,
+        .read = readGPIO,
+        .write = writeGPIO,
+    });
+}
@@ -0,0 +1,47 @@
+///
+/// gpioDevice.h
+/// A stand-in for the Raspberry Pi's GPIO controller, logging pin changes.
+///
+
+#ifndef EMULATOR_GPIO_DEVICE_H
+#define EMULATOR_GPIO_DEVICE_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "clock.h"
+#include "const.h"
+#include "mmio.h"
+
+/// The physical base address of the GPIO controller on the BCM2837.
+#define GPIO_BASE     0x3f200000
+
+/// The number of bytes of register space the GPIO controller occupies.
+#define GPIO_SIZE     0xB4
+
+/// The number of GPIO pins.
+#define GPIO_PINS     54
+
+/// Offset of the first function select register, GPFSEL0. Each covers 10 pins.
+#define GPIO_GPFSEL0  0x00
+
+/// Offset of the last function select register, GPFSEL5, which is followed by a reserved word.
+#define GPIO_GPFSEL5  0x14
+
+/// Offset of the first pin output set register, GPSET0.
+#define GPIO_GPSET0   0x1C
+
+/// Offset of the first pin output clear register, GPCLR0.
+#define GPIO_GPCLR0   0x28
+
+/// Offset of the first pin level register, GPLEV0.
+#define GPIO_GPLEV0   0x34
+
+/// The function select value configuring a pin as an output.
+#define GPIO_FSEL_OUT b(001)
+
+void attachGPIO(FILE *log);
+
+#endif // EMULATOR_GPIO_DEVICE_H
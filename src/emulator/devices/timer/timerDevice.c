@@ -0,0 +1,145 @@
+///
+/// timerDevice.c
+/// A model of the Raspberry Pi's free-running system timer, driven by virtual time.
+///
+
+#include "timerDevice.h"
+
+/// A compare channel of the system timer.
+typedef struct {
+
+    /// The compare register, C0 to C3.
+    uint32_t compare;
+
+    /// The virtual time at which the counter next equals [compare].
+    uint64_t due;
+
+} Channel;
+
+/// The state of the system timer.
+typedef struct {
+
+    /// The compare channels.
+    Channel channels[TIMER_CHANNELS];
+
+    /// The match bits of the control/status register.
+    uint32_t cs;
+
+    /// Whether an event is pending for the next tick of the counter.
+    bool tickPending;
+
+} Timer;
+
+/// The single system timer of the machine.
+static Timer timer;
+
+/// Gets the current value of the 64-bit free-running counter.
+/// @returns The number of ticks since the last reset.
+static uint64_t getTicks(void) {
+    return getClock() / TIMER_CYCLES_PER_TICK;
+}
+
+/// Called when the counter ticks over while the guest is polling it.
+/// @param context Unused.
+static void handleTick(unused void *context) {
+    timer.tickPending = false;
+}
+
+/// Called when the counter reaches a channel's compare value.
+/// @param context The [Channel] matched.
+static void handleMatch(void *context) {
+    Channel *channel = (Channel *) context;
+
+    // Events fire exactly when due, so any other time means the channel was re-programmed since.
+    if (channel->due != getClock()) return;
+    timer.cs |= 1 << (channel - timer.channels);
+}
+
+/// Handles a read from a system timer register.
+/// @param device Unused; there is only one timer.
+/// @param offset The offset of the register within the timer.
+/// @param as64 Whether to read 64 or 32 bits.
+/// @returns The register's contents.
+static BitData readTimer(unused void *device, size_t offset, bool as64) {
+    assertFatal(!as64, "<Timer> Registers must be accessed with 32-bit reads!");
+    assertFatalWithArgs(offset % sizeof(uint32_t) == 0, "<Timer> Received unaligned read at offset 0x%zx!", offset);
+
+    switch (offset) {
+        case TIMER_CS:
+            return timer.cs;
+
+        case TIMER_CLO:
+        case TIMER_CHI:
+            // The counter is the only register to change without an event, so a guest polling it
+            // must be woken by one when it next ticks over, lest idle skipping jump past it.
+            if (!timer.tickPending) {
+                timer.tickPending = true;
+                scheduleEvent((getTicks() + 1) * TIMER_CYCLES_PER_TICK, handleTick, NULL);
+            }
+            return (uint32_t) (getTicks() >> (offset - TIMER_CLO) * 8);
+
+        case TIMER_C0:
+        case TIMER_C1:
+        case TIMER_C2:
+        case TIMER_C3:
+            return timer.channels[(offset - TIMER_C0) / sizeof(uint32_t)].compare;
+
+        default:
+            throwFatalWithArgs("<Timer> Received read from unknown register at offset 0x%zx!", offset);
+    }
+}
+
+/// Handles a write to a system timer register.
+/// @param device Unused; there is only one timer.
+/// @param offset The offset of the register within the timer.
+/// @param as64 Whether to write 64 or 32 bits.
+/// @param value The value written.
+static void writeTimer(unused void *device, size_t offset, bool as64, BitData value) {
+    assertFatal(!as64, "<Timer> Registers must be accessed with 32-bit writes!");
+    assertFatalWithArgs(offset % sizeof(uint32_t) == 0, "<Timer> Received unaligned write at offset 0x%zx!", offset);
+
+    switch (offset) {
+        case TIMER_CS:
+            // Writing a one clears the corresponding match bit.
+            timer.cs &= ~value;
+            break;
+
+        case TIMER_CLO:
+        case TIMER_CHI:
+            // The counter is read-only.
+            break;
+
+        case TIMER_C0:
+        case TIMER_C1:
+        case TIMER_C2:
+        case TIMER_C3: {
+            Channel *channel = &timer.channels[(offset - TIMER_C0) / sizeof(uint32_t)];
+            channel->compare = value;
+
+            // Matches happen when the lower 32 bits of the counter next equal [compare].
+            uint64_t ticks = getTicks();
+            uint64_t delta = (uint32_t) (channel->compare - (uint32_t) ticks);
+            if (delta == 0) delta = (uint64_t) 1 << 32;
+
+            channel->due = (ticks + delta) * TIMER_CYCLES_PER_TICK;
+            scheduleEvent(channel->due, handleMatch, channel);
+            break;
+        }
+
+        default:
+            throwFatalWithArgs("<Timer> Received write to unknown register at offset 0x%zx!", offset);
+    }
+}
+
+/// Resets the system timer and maps it into the physical address space.
+void attachTimer(void) {
+    timer = (Timer) { 0 };
+    mapRegion((MMIORegion) {
+        .name = "Timer",
+        .base = TIMER_BASE,
+        .size = TIMER_SIZE,
+        .device = &timer,
+        .read = readTimer,
+        .write = writeTimer,
+    });
+}
@@ -0,0 +1,46 @@
+///
+/// timerDevice.h
+/// A model of the Raspberry Pi's free-running system timer, driven by virtual time.
+///
+
+#ifndef EMULATOR_TIMER_DEVICE_H
+#define EMULATOR_TIMER_DEVICE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "clock.h"
+#include "const.h"
+#include "mmio.h"
+#include "scheduler.h"
+
+/// The physical base address of the system timer on the BCM2837.
+#define TIMER_BASE            0x3f003000
+
+/// The number of bytes of register space the system timer occupies.
+#define TIMER_SIZE            0x1C
+
+/// The number of virtual cycles per tick of the 1MHz timer, i.e., a 1GHz virtual core.
+#define TIMER_CYCLES_PER_TICK 1000
+
+/// The number of compare channels.
+#define TIMER_CHANNELS        4
+
+/// Offset of the control/status register, CS, holding one match bit per channel.
+#define TIMER_CS              0x00
+
+/// Offset of the lower 32 bits of the counter, CLO.
+#define TIMER_CLO             0x04
+
+/// Offset of the higher 32 bits of the counter, CHI.
+#define TIMER_CHI             0x08
+
+/// Offsets of the compare registers, C0 to C3, one per channel.
+#define TIMER_C0              0x0C
+#define TIMER_C1              0x10
+#define TIMER_C2              0x14
+#define TIMER_C3              0x18
+
+void attachTimer(void);
+
+#endif // EMULATOR_TIMER_DEVICE_H
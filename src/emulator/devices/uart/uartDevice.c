@@ -0,0 +1,102 @@
+///
+/// uartDevice.c
+/// A transmit-only model of the Raspberry Pi's PL011 UART, buffering guest console output.
+///
+
+#include "uartDevice.h"
+
+/// The state of the UART.
+typedef struct {
+
+    /// The ring buffer of transmitted bytes not yet written out.
+    char buffer[UART_BUFFER_SIZE];
+
+    /// The index of the oldest byte in [buffer].
+    size_t head;
+
+    /// The number of bytes in [buffer].
+    size_t count;
+
+    /// Whether a flush event is pending.
+    bool flushPending;
+
+    /// Where transmitted bytes are written out to.
+    FILE *out;
+
+} UART;
+
+/// The single UART of the machine.
+static UART uart;
+
+/// Writes out all buffered bytes, in at most two batches since [buffer] may wrap around.
+void flushUART(void) {
+    if (uart.out == NULL || uart.count == 0) return;
+
+    size_t firstLength = uart.count;
+    if (uart.head + firstLength > UART_BUFFER_SIZE) firstLength = UART_BUFFER_SIZE - uart.head;
+
+    fwrite(uart.buffer + uart.head, 1, firstLength, uart.out);
+    fwrite(uart.buffer, 1, uart.count - firstLength, uart.out);
+    fflush(uart.out);
+
+    uart.head = 0;
+    uart.count = 0;
+}
+
+/// Called once buffered output has waited long enough in virtual time.
+/// @param context Unused.
+static void handleFlush(unused void *context) {
+    uart.flushPending = false;
+    flushUART();
+}
+
+/// Handles a read from a UART register.
+/// @param device Unused; there is only one UART.
+/// @param offset The offset of the register within the UART.
+/// @param as64 Whether to read 64 or 32 bits.
+/// @returns The register's contents.
+static BitData readUART(unused void *device, size_t offset, bool as64) {
+    assertFatal(!as64, "<UART> Registers must be accessed with 32-bit reads!");
+
+    // Nothing is ever received, and the transmitter is never busy.
+    return (offset == UART_FR) ? UART_FR_READY : 0;
+}
+
+/// Handles a write to a UART register.
+/// @param device Unused; there is only one UART.
+/// @param offset The offset of the register within the UART.
+/// @param as64 Whether to write 64 or 32 bits.
+/// @param value The value written.
+static void writeUART(unused void *device, size_t offset, bool as64, BitData value) {
+    assertFatal(!as64, "<UART> Registers must be accessed with 32-bit writes!");
+
+    // Baud rate, line control, and interrupt registers have no effect on a virtual line.
+    if (offset != UART_DR) return;
+
+    if (uart.count == UART_BUFFER_SIZE) flushUART();
+    uart.buffer[(uart.head + uart.count++) % UART_BUFFER_SIZE] = (char) value;
+
+    // Make sure slow trickles of output still show up in good time.
+    if (!uart.flushPending) {
+        uart.flushPending = true;
+        scheduleEvent(getClock() + UART_FLUSH_INTERVAL, handleFlush, NULL);
+    }
+}
+
+/// Resets the UART and maps it into the physical address space.
+/// @param out Where to write transmitted bytes to, or NULL to discard them.
+void attachUART(FILE *out) {
+    uart.head = 0;
+    uart.count = 0;
+    uart.flushPending = false;
+    uart.out = out;
+
+    mapRegion((MMIORegion) {
+        .name = "UART",
+        .base = UART_BASE,
+        .size = UART_SIZE,
+        .device = &uart,
+        .read = readUART,
+        .write = writeUART,
+    });
+}
@@ -0,0 +1,44 @@
+///
+/// uartDevice.h
+/// A transmit-only model of the Raspberry Pi's PL011 UART, buffering guest console output.
+///
+
+#ifndef EMULATOR_UART_DEVICE_H
+#define EMULATOR_UART_DEVICE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "clock.h"
+#include "const.h"
+#include "mmio.h"
+#include "scheduler.h"
+
+/// The physical base address of the PL011 UART on the BCM2837.
+#define UART_BASE           0x3f201000
+
+/// The number of bytes of register space the UART occupies.
+#define UART_SIZE           0x90
+
+/// Offset of the data register, DR. Writing transmits the lowest byte.
+#define UART_DR             0x00
+
+/// Offset of the flag register, FR.
+#define UART_FR             0x18
+
+/// Flag register value: transmit FIFO empty and receive FIFO empty, i.e., always ready to send.
+#define UART_FR_READY       (1 << 7 | 1 << 4)
+
+/// The number of bytes buffered on the host before being written out.
+#define UART_BUFFER_SIZE    (64 << 10)
+
+/// The virtual time after which buffered output is written out regardless, i.e., 10ms.
+#define UART_FLUSH_INTERVAL 10000000
+
+void attachUART(FILE *out);
+
+void flushUART(void);
+
+#endif // EMULATOR_UART_DEVICE_H
@@ -7,6 +7,20 @@
 
 #include "emulatorDelegate.h"
 
+/// The state seen when last branching backwards, used to spot the guest spinning idle.
+static struct {
+
+    /// Whether [registers] and [writes] hold a snapshot.
+    bool valid;
+
+    /// The registers, including the PC of the loop head, after the branch.
+    Registers_s registers;
+
+    /// The number of memory writes made up to the branch.
+    uint64_t writes;
+
+} idle;
+
 /// Get the corresponding [IRExecutor] for this [irObject].
 /// @param instruction The binary representation of the instruction.
 /// @returns The corresponding [IRExecutor].
@@ -24,6 +38,9 @@ Executor getExecuteFunction(IR *irObject) {
         case BRANCH:
             return executeBranch;
 
+        case SYSTEM:
+            return executeSystem;
+
         default:
             throwFatal("Invalid IR!");
     }
@@ -41,12 +58,30 @@ Decoder getDecodeFunction(const Instruction instruction) {
     } else if ((op0 & OP0_LOAD_STORE_M) == OP0_LOAD_STORE_C) {
         return decodeLoadStore;
     } else if ((op0 & OP0_BRANCH_M) == OP0_BRANCH_C) {
-        return decodeBranch;
+        // System instructions share op0 with branches.
+        return (instruction & SYSTEM_M) == SYSTEM_B ? decodeSystem : decodeBranch;
     }
 
     throwFatal("Invalid binary instruction!");
 }
 
+/// Jumps virtual time to the next pending event if the guest is provably idle, i.e., it has
+/// come back round a loop to the exact same state without writing to memory. From there on it
+/// can only behave differently once some device changes what it reads, which takes an event.
+/// @param registers The current virtual registers, just after a backwards branch.
+static void skipIfIdle(Registers registers) {
+    if (idle.valid && idle.writes == getMemWrites() && equalRegs(&idle.registers, registers)) {
+        uint64_t time;
+        assertFatal(nextEventTime(&time), "Guest is spinning idle with no pending events!");
+        advanceClock(time);
+        return;
+    }
+
+    idle.valid = true;
+    idle.registers = *registers;
+    idle.writes = getMemWrites();
+}
+
 /// Executes [instruction] given context.
 /// @param instruction The binary instruction to execute.
 /// @param registers The current virtual registers.
@@ -59,9 +94,29 @@ void execute(Instruction *instruction, Registers registers, Memory memory) {
     IR ir = getDecodeFunction(*instruction)(*instruction);
     getExecuteFunction(&ir)(&ir, registers, memory);
 
+    tickClock();
+
     // Increment PC only when no branch or jump instructions applied.
-    if (pcVal == getRegPC(registers)) incRegPC(registers);
+    // Branching backwards may mean the guest is spinning in a loop.
+    if (pcVal == getRegPC(registers)) {
+        incRegPC(registers);
+    } else if (getRegPC(registers) < pcVal) {
+        skipIfIdle(registers);
+    }
+
+    runDueEvents();
+
+    // The fault handler let a write to a watched page through; report it and protect the page again.
+    if (isWatchpointPending()) finishWatchpoint(pcVal);
+
+    // Fetch next instruction, unless the guest asked to stop.
+    *instruction = hasExited() ? HALT : readMem(memory, false, getRegPC(registers));
+}
 
-    // Fetch next instruction
-    *instruction = readMem(memory, false, getRegPC(registers));
+/// Resets virtual time, pending device events, semihosting, and idle detection before running a fresh program.
+void resetMachine(void) {
+    resetClock();
+    resetScheduler();
+    resetSemihosting();
+    idle.valid = false;
 }
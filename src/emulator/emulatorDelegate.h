@@ -10,6 +10,7 @@
 
 #include "branchDecoder.h"
 #include "branchExecutor.h"
+#include "clock.h"
 #include "const.h"
 #include "error.h"
 #include "immediateDecoder.h"
@@ -21,6 +22,14 @@
 #include "registerDecoder.h"
 #include "registerExecutor.h"
 #include "registers.h"
+#include "scheduler.h"
+#include "semihosting.h"
+#include "systemDecoder.h"
+#include "systemExecutor.h"
+#include "watchpoint.h"
+
+/// The instruction that stops emulation.
+#define HALT             0x8a000000
 
 /// OP0 Mask
 #define OP0_M            mask(28, 25)
@@ -59,4 +68,6 @@ Decoder getDecodeFunction(Instruction instruction);
 
 void execute(Instruction *instruction, Registers registers, Memory memory);
 
+void resetMachine(void);
+
 #endif // EMULATOR_PROCESS_H
@@ -0,0 +1,38 @@
+///
+/// systemExecutor.c
+/// Execute a system instruction from its intermediate representation (IR)
+///
+
+#include "systemExecutor.h"
+
+/// Executes an [IR] of a system instruction.
+/// @param irObject The instruction to execute.
+/// @param registers The current virtual registers.
+/// @param memory The current virtual memory.
+void executeSystem(IR *irObject, Registers registers, Memory memory) {
+    assertFatal(irObject->type == SYSTEM, "Received non-system instruction!");
+    System_IR *systemIR = &irObject->ir.systemIR;
+
+    switch (systemIR->type) {
+        case SYSTEM_HLT:
+            // There is no debugger to halt for, so only semihosting requests are meaningful.
+            assertFatalWithArgs(systemIR->data.imm16 == SEMIHOSTING_HLT,
+                                "Unsupported halt number <0x%x>!", systemIR->data.imm16);
+            semihost(registers, memory);
+            break;
+
+        case SYSTEM_MRS: {
+            struct Mrs *mrs = &systemIR->data.mrs;
+            switch (mrs->sysreg) {
+                case PMCCNTR_EL0:
+                    setReg(registers, mrs->rt, true, getClock());
+                    break;
+
+                case CNTVCT_EL0:
+                    setReg(registers, mrs->rt, true, getRetired());
+                    break;
+            }
+            break;
+        }
+    }
+}
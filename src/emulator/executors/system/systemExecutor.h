@@ -0,0 +1,19 @@
+///
+/// systemExecutor.h
+/// Execute a system instruction from its intermediate representation (IR)
+///
+
+#ifndef EMULATOR_SYSTEM_EXECUTOR_H
+#define EMULATOR_SYSTEM_EXECUTOR_H
+
+#include "clock.h"
+#include "const.h"
+#include "error.h"
+#include "ir.h"
+#include "memory.h"
+#include "registers.h"
+#include "semihosting.h"
+
+void executeSystem(IR *irObject, Registers registers, Memory memory);
+
+#endif // EMULATOR_SYSTEM_EXECUTOR_H
@@ -0,0 +1,44 @@
+///
+/// clock.c
+/// The virtual clock of the emulated machine, driven by retired instructions.
+///
+
+#include "clock.h"
+
+/// The number of instructions retired since the last reset.
+static uint64_t retired = 0;
+
+/// The virtual time in cycles since the last reset. Every instruction takes one cycle, but
+/// time may also jump forward while the guest is idle.
+static uint64_t cycles = 0;
+
+/// Resets the virtual clock back to zero, e.g., before running a fresh program.
+void resetClock(void) {
+    retired = 0;
+    cycles = 0;
+}
+
+/// Advances the virtual clock by one retired instruction.
+void tickClock(void) {
+    retired++;
+    cycles++;
+}
+
+/// Jumps the virtual clock forward to [time] without retiring any instructions.
+/// @param time The virtual time to jump to.
+void advanceClock(uint64_t time) {
+    assertFatal(time >= cycles, "<Clock> Cannot move virtual time backwards!");
+    cycles = time;
+}
+
+/// Gets the current virtual time.
+/// @returns The number of cycles elapsed since the last reset.
+uint64_t getClock(void) {
+    return cycles;
+}
+
+/// Gets the number of instructions retired.
+/// @returns The number of instructions retired since the last reset.
+uint64_t getRetired(void) {
+    return retired;
+}
@@ -0,0 +1,24 @@
+///
+/// clock.h
+/// The virtual clock of the emulated machine, driven by retired instructions.
+///
+
+#ifndef EMULATOR_CLOCK_H
+#define EMULATOR_CLOCK_H
+
+#include <stdint.h>
+
+#include "const.h"
+#include "error.h"
+
+void resetClock(void);
+
+void tickClock(void);
+
+void advanceClock(uint64_t time);
+
+uint64_t getClock(void);
+
+uint64_t getRetired(void);
+
+#endif // EMULATOR_CLOCK_H
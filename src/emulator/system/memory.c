@@ -7,6 +7,9 @@
 
 #include "memory.h"
 
+/// The number of writes made to virtual memory, including memory-mapped devices.
+static uint64_t writes = 0;
+
 /// Allocates a chunk of virtual memory preloaded with the contents of the given file handler.
 /// @param fd File handler of initial contents.
 /// @returns Generic pointer to memory.
@@ -56,13 +59,16 @@ void freeMem(Memory memory) {
 }
 
 /// Reads 64/32-bits from virtual memory. If 32-bits is selected, higher bits will be set to 0.
+/// Reads beyond the end of RAM are forwarded to the memory-mapped device at [addr], if any.
 /// @param memory The address of the virtual memory.
 /// @param as64 Whether to read 64 or 32 bits.
 /// @param addr The address within the virtual memory.
 /// @returns The 64-bit value at mem + addr.
 BitData readMem(Memory memory, bool as64, size_t addr) {
     size_t readSize = as64 ? sizeof(uint64_t) : sizeof(uint32_t);
-    assertFatal(addr + readSize <= MEMORY_SIZE, "<Memory> Received out-of-bound read to memory!");
+
+    // Anything beyond RAM must be a memory-mapped device.
+    if (addr + readSize > MEMORY_SIZE) return readMMIO(addr, as64);
 
     // Read virtual memory as little-endian.
     uint8_t *ptr = (uint8_t *) memory + addr;
@@ -74,16 +80,44 @@ BitData readMem(Memory memory, bool as64, size_t addr) {
 }
 
 /// Writes 64/32-bits to virtual memory. If 32-bits is selected, the higher bits of [value] will be ignored.
+/// Writes beyond the end of RAM are forwarded to the memory-mapped device at [addr], if any.
 /// @param memory The address of the virtual memory.
 /// @param as64 Whether to write 64 or 32 bits.
 /// @param addr The address within the virtual memory.
 /// @param value The value to write.
 void writeMem(Memory memory, bool as64, size_t addr, BitData value) {
     size_t writeSize = as64 ? sizeof(uint64_t) : sizeof(uint32_t);
-    assertFatal(addr + writeSize <= MEMORY_SIZE, "Received out-of-bound read to memory!");
+    writes++;
+
+    // Anything beyond RAM must be a memory-mapped device.
+    if (addr + writeSize > MEMORY_SIZE) {
+        writeMMIO(addr, as64, value);
+        return;
+    }
 
     uint8_t *ptr = (uint8_t *) memory + addr;
     for (size_t i = 0; i < writeSize; i++) {
         ptr[i] = (uint8_t) (value >> 8 * i);
     }
 }
+
+/// Gets a host pointer to a range of RAM, for bulk transfers that bypass [readMem] and [writeMem].
+/// @param memory The address of the virtual memory.
+/// @param addr The address within the virtual memory.
+/// @param length The number of bytes in the range.
+/// @returns The host address of [addr].
+/// @remark The range must lie in RAM; memory-mapped devices only take single accesses.
+uint8_t *getMemRange(Memory memory, size_t addr, size_t length) {
+    assertFatalWithArgs(addr <= MEMORY_SIZE && length <= MEMORY_SIZE - addr,
+                        "<Memory> Received out-of-bound range at address 0x%zx!", addr);
+    // The caller may write through the pointer.
+    writes++;
+    return (uint8_t *) memory + addr;
+}
+
+/// Counts the writes made to virtual memory so far.
+/// @returns The number of writes made, including to memory-mapped devices.
+/// @remark Comparing two counts tells whether memory may have changed in between.
+uint64_t getMemWrites(void) {
+    return writes;
+}
@@ -20,6 +20,7 @@
 
 #include "const.h"
 #include "error.h"
+#include "mmio.h"
 
 /// Type definition representing virtual memory.
 typedef void *Memory;
@@ -34,4 +35,8 @@ BitData readMem(Memory mem, bool as64, size_t addr);
 
 void writeMem(Memory mem, bool as64, size_t addr, BitData value);
 
+uint8_t *getMemRange(Memory mem, size_t addr, size_t length);
+
+uint64_t getMemWrites(void);
+
 #endif // EMULATOR_MEMORY_H
@@ -0,0 +1,59 @@
+///
+/// mmio.c
+/// The table of memory-mapped device regions lying outside of RAM.
+///
+
+#include "mmio.h"
+
+/// All currently mapped device regions.
+static MMIORegion regions[MAX_MMIO_REGIONS];
+
+/// The number of [MMIORegion]s in [regions].
+static size_t regionCount = 0;
+
+/// Maps a device into the physical address space.
+/// @param region The device and the addresses it covers.
+/// @pre [region] lies entirely outside of RAM and overlaps no other region.
+void mapRegion(MMIORegion region) {
+    assertFatal(regionCount < MAX_MMIO_REGIONS, "<MMIO> Too many devices mapped!");
+    assertFatalWithArgs(region.base >= MEMORY_SIZE,
+                        "<MMIO> Device <%s> overlaps RAM!", region.name);
+    regions[regionCount++] = region;
+}
+
+/// Unmaps all devices, leaving only RAM addressable.
+void unmapRegions(void) {
+    regionCount = 0;
+}
+
+/// Finds the region covering [size] bytes starting from [addr].
+/// @param addr The physical address accessed.
+/// @param size The width of the access in bytes.
+/// @returns The covering region, or NULL if there is none.
+static MMIORegion *findRegion(size_t addr, size_t size) {
+    for (size_t i = 0; i < regionCount; i++) {
+        MMIORegion *region = &regions[i];
+        if (addr >= region->base && addr - region->base + size <= region->size) return region;
+    }
+    return NULL;
+}
+
+/// Reads 64/32-bits from whichever device is mapped at [addr].
+/// @param addr The physical address to read from.
+/// @param as64 Whether to read 64 or 32 bits.
+/// @returns The value produced by the device.
+BitData readMMIO(size_t addr, bool as64) {
+    MMIORegion *region = findRegion(addr, as64 ? sizeof(uint64_t) : sizeof(uint32_t));
+    assertFatalNotNullWithArgs(region, "<Memory> Received out-of-bound read to address 0x%zx!", addr);
+    return region->read(region->device, addr - region->base, as64);
+}
+
+/// Writes 64/32-bits to whichever device is mapped at [addr].
+/// @param addr The physical address to write to.
+/// @param as64 Whether to write 64 or 32 bits.
+/// @param value The value to write.
+void writeMMIO(size_t addr, bool as64, BitData value) {
+    MMIORegion *region = findRegion(addr, as64 ? sizeof(uint64_t) : sizeof(uint32_t));
+    assertFatalNotNullWithArgs(region, "<Memory> Received out-of-bound write to address 0x%zx!", addr);
+    region->write(region->device, addr - region->base, as64, value);
+}
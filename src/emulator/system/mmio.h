@@ -0,0 +1,55 @@
+///
+/// mmio.h
+/// The table of memory-mapped device regions lying outside of RAM.
+///
+
+#ifndef EMULATOR_MMIO_H
+#define EMULATOR_MMIO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "const.h"
+#include "error.h"
+
+/// The maximum number of devices which may be mapped at once.
+#define MAX_MMIO_REGIONS 8
+
+/// A function which handles a read from a device register.
+typedef BitData (*MMIORead)(void *device, size_t offset, bool as64);
+
+/// A function which handles a write to a device register.
+typedef void (*MMIOWrite)(void *device, size_t offset, bool as64, BitData value);
+
+/// A device mapped into the physical address space.
+typedef struct {
+
+    /// The human-readable name of the device, for error messages.
+    const char *name;
+
+    /// The first physical address covered by the device.
+    size_t base;
+
+    /// The number of bytes covered by the device.
+    size_t size;
+
+    /// The device state passed back to [read] and [write].
+    void *device;
+
+    /// Handles reads within [base, base + size).
+    MMIORead read;
+
+    /// Handles writes within [base, base + size).
+    MMIOWrite write;
+
+} MMIORegion;
+
+void mapRegion(MMIORegion region);
+
+void unmapRegions(void);
+
+BitData readMMIO(size_t addr, bool as64);
+
+void writeMMIO(size_t addr, bool as64, BitData value);
+
+#endif // EMULATOR_MMIO_H
@@ -72,6 +72,20 @@ bool getRegState(Registers registers, PStateField field) {
     }
 }
 
+/// Determines whether two sets of registers hold identical architectural state.
+/// @param registers Pointer to the registers.
+/// @param other Pointer to the registers to compare against.
+/// @return Whether every register and PState flag is identical.
+bool equalRegs(Registers registers, Registers other) {
+    return !memcmp(registers->gprs, other->gprs, sizeof(registers->gprs))
+        && registers->pc == other->pc
+        && registers->sp == other->sp
+        && registers->pstate.ng == other->pstate.ng
+        && registers->pstate.zr == other->pstate.zr
+        && registers->pstate.cr == other->pstate.cr
+        && registers->pstate.ov == other->pstate.ov;
+}
+
 /// Sets the value of a register; choice between 32 or 64-bit.
 /// @param registers Pointer to the registers.
 /// @param id The ID of the register to access.
@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <string.h>
 
 #include "const.h"
 #include "error.h"
@@ -77,6 +78,8 @@ BitData getRegSP(Registers regs);
 
 bool getRegState(Registers regs, PStateField field);
 
+bool equalRegs(Registers regs, Registers other);
+
 void setReg(Registers regs, size_t id, bool as64, BitData value);
 
 void setRegPC(Registers regs, BitData value);
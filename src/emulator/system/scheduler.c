@@ -0,0 +1,89 @@
+///
+/// scheduler.c
+/// A queue of device events ordered by the virtual time they are due at.
+///
+
+#include "scheduler.h"
+
+/// A binary min-heap of pending events, keyed on [Event.time].
+static Event *events = NULL;
+
+/// The number of [Event]s in [events].
+static size_t eventCount = 0;
+
+/// The maximum number of [Event]s that [events] is currently allocated for.
+static size_t eventMaxCount = 0;
+
+/// Drops all pending events.
+void resetScheduler(void) {
+    eventCount = 0;
+}
+
+/// Swaps two events in the heap.
+/// @param i The index of the first event.
+/// @param j The index of the second event.
+static void swapEvents(size_t i, size_t j) {
+    Event temp = events[i];
+    events[i] = events[j];
+    events[j] = temp;
+}
+
+/// Schedules [handler] to be called with [context] once virtual time reaches [time].
+/// @param time The virtual time the event is due at.
+/// @param handler The function to call.
+/// @param context The value to pass to [handler].
+void scheduleEvent(uint64_t time, EventHandler handler, void *context) {
+    if (eventCount >= eventMaxCount) {
+        // Exponential (doubling) scaling policy.
+        eventMaxCount = eventMaxCount ? eventMaxCount * 2 : INITIAL_EVENT_COUNT;
+        events = realloc(events, eventMaxCount * sizeof(Event));
+        assertFatalNotNull(events, "<Memory> Unable to expand by re-allocate [events]!");
+    }
+
+    // Sift the new event up to its place.
+    size_t i = eventCount++;
+    events[i] = (Event) { time, handler, context };
+    while (i > 0 && events[(i - 1) / 2].time > events[i].time) {
+        swapEvents(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+/// Gets the virtual time of the earliest pending event.
+/// @param[out] time The virtual time the next event is due at.
+/// @returns Whether there is a pending event.
+bool nextEventTime(uint64_t *time) {
+    if (eventCount == 0) return false;
+    *time = events[0].time;
+    return true;
+}
+
+/// Removes the earliest pending event from the heap.
+/// @returns The removed event.
+static Event popEvent(void) {
+    Event top = events[0];
+    events[0] = events[--eventCount];
+
+    // Sift the moved event down to its place.
+    size_t i = 0;
+    while (true) {
+        size_t smallest = i;
+        size_t left = 2 * i + 1, right = 2 * i + 2;
+        if (left < eventCount && events[left].time < events[smallest].time) smallest = left;
+        if (right < eventCount && events[right].time < events[smallest].time) smallest = right;
+        if (smallest == i) break;
+        swapEvents(i, smallest);
+        i = smallest;
+    }
+
+    return top;
+}
+
+/// Calls the handlers of all events due at or before the current virtual time, earliest first.
+void runDueEvents(void) {
+    while (eventCount > 0 && events[0].time <= getClock()) {
+        // Pop before calling, since handlers may schedule further events.
+        Event event = popEvent();
+        event.handler(event.context);
+    }
+}
@@ -0,0 +1,43 @@
+///
+/// scheduler.h
+/// A queue of device events ordered by the virtual time they are due at.
+///
+
+#ifndef EMULATOR_SCHEDULER_H
+#define EMULATOR_SCHEDULER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "clock.h"
+#include "error.h"
+
+#define INITIAL_EVENT_COUNT 16
+
+/// A function called when an event becomes due.
+typedef void (*EventHandler)(void *context);
+
+/// A device event scheduled for some point in virtual time.
+typedef struct {
+
+    /// The virtual time the event is due at.
+    uint64_t time;
+
+    /// Called once virtual time reaches [time].
+    EventHandler handler;
+
+    /// Passed to [handler].
+    void *context;
+
+} Event;
+
+void resetScheduler(void);
+
+void scheduleEvent(uint64_t time, EventHandler handler, void *context);
+
+bool nextEventTime(uint64_t *time);
+
+void runDueEvents(void);
+
+#endif // EMULATOR_SCHEDULER_H
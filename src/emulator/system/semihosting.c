@@ -0,0 +1,187 @@
+///
+/// semihosting.c
+/// Serves guest requests for host file and process operations, made through [SEMIHOSTING_HLT].
+///
+
+#include "semihosting.h"
+
+/// A host file the guest has a handle to.
+typedef struct {
+
+    /// Whether the handle is in use.
+    bool open;
+
+    /// The host file descriptor.
+    int fd;
+
+    /// Whether [fd] was opened for the guest, and so must be closed with the handle.
+    bool owned;
+
+} HostFile;
+
+/// The guest's handles, where handle [i] is [files[i - 1]], as zero is not a valid handle.
+static HostFile files[MAX_SEMIHOSTING_FILES];
+
+/// Whether the guest has asked to stop.
+static bool exited = false;
+
+/// The status the guest asked to exit with.
+static int exitStatus = EXIT_SUCCESS;
+
+/// The host [open] flags for each [SYS_OPEN] mode, in the order of the [fopen] modes they mirror.
+static const int openFlags[] = {
+    O_RDONLY,                      O_RDONLY,                      // "r", "rb"
+    O_RDWR,                        O_RDWR,                        // "r+", "r+b"
+    O_WRONLY | O_CREAT | O_TRUNC,  O_WRONLY | O_CREAT | O_TRUNC,  // "w", "wb"
+    O_RDWR | O_CREAT | O_TRUNC,    O_RDWR | O_CREAT | O_TRUNC,    // "w+", "w+b"
+    O_WRONLY | O_CREAT | O_APPEND, O_WRONLY | O_CREAT | O_APPEND, // "a", "ab"
+    O_RDWR | O_CREAT | O_APPEND,   O_RDWR | O_CREAT | O_APPEND,   // "a+", "a+b"
+};
+
+/// Reads a field of the parameter block of a semihosting request.
+/// @param memory The current virtual memory.
+/// @param block The address of the parameter block.
+/// @param index The index of the field.
+/// @returns The 64-bit field.
+static BitData getParam(Memory memory, BitData block, size_t index) {
+    return readMem(memory, true, block + index * sizeof(uint64_t));
+}
+
+/// Finds the host file behind a guest handle.
+/// @param handle The guest handle.
+/// @returns The [HostFile], or NULL if [handle] is not open.
+static HostFile *getFile(BitData handle) {
+    if (handle == 0 || handle > MAX_SEMIHOSTING_FILES || !files[handle - 1].open) return NULL;
+    return &files[handle - 1];
+}
+
+/// Opens a host file for the guest.
+/// @param memory The current virtual memory.
+/// @param block The address of the parameter block.
+/// @returns The new handle, or -1 on failure.
+static BitData sysOpen(Memory memory, BitData block) {
+    BitData mode = getParam(memory, block, 1);
+    BitData length = getParam(memory, block, 2);
+    if (mode >= sizeof(openFlags) / sizeof(int)) return -1;
+
+    size_t handle = 0;
+    while (handle < MAX_SEMIHOSTING_FILES && files[handle].open) handle++;
+    if (handle == MAX_SEMIHOSTING_FILES) return -1;
+
+    char *path = strndup((char *) getMemRange(memory, getParam(memory, block, 0), length), length);
+    assertFatalNotNull(path, "<Memory> Unable to allocate [char *]!");
+
+    // The special path ":tt" is the console: stdin for reading, stdout for writing, stderr for appending.
+    HostFile file = { .open = true, .owned = strcmp(path, ":tt") != 0 };
+    if (file.owned) {
+        file.fd = open(path, openFlags[mode], 0666);
+    } else {
+        file.fd = mode < 4 ? STDIN_FILENO : mode < 8 ? STDOUT_FILENO : STDERR_FILENO;
+    }
+    free(path);
+
+    if (file.fd < 0) return -1;
+    files[handle] = file;
+    return handle + 1;
+}
+
+/// Closes a guest handle.
+/// @param memory The current virtual memory.
+/// @param block The address of the parameter block.
+/// @returns 0 on success, or -1 on failure.
+static BitData sysClose(Memory memory, BitData block) {
+    HostFile *file = getFile(getParam(memory, block, 0));
+    if (file == NULL) return -1;
+
+    file->open = false;
+    if (file->owned && close(file->fd) != 0) return -1;
+    return 0;
+}
+
+/// Transfers bytes between guest memory and a guest handle, directly in and out of RAM.
+/// @param memory The current virtual memory.
+/// @param block The address of the parameter block.
+/// @param toGuest Whether to read from the handle into memory, rather than write to it.
+/// @returns The number of bytes not transferred, so 0 on success.
+static BitData sysTransfer(Memory memory, BitData block, bool toGuest) {
+    HostFile *file = getFile(getParam(memory, block, 0));
+    BitData length = getParam(memory, block, 2);
+    if (file == NULL) return length;
+
+    BitData address = getParam(memory, block, 1);
+    uint8_t *buffer = getMemRange(memory, address, length);
+    if (toGuest) watchTransfer(memory, address, length);
+
+    // Console output the UART still holds was sent first, so must reach the terminal first.
+    if (!toGuest && (file->fd == STDOUT_FILENO || file->fd == STDERR_FILENO)) flushUART();
+
+    size_t done = 0;
+    while (done < length) {
+        ssize_t count = toGuest ? read(file->fd, buffer + done, length - done)
+                                : write(file->fd, buffer + done, length - done);
+        if (count <= 0) break;
+        done += count;
+    }
+    return length - done;
+}
+
+/// Serves the semihosting request in [w0], with the parameter block at [x1], placing the result in [x0].
+/// @param registers The current virtual registers.
+/// @param memory The current virtual memory.
+void semihost(Registers registers, Memory memory) {
+    uint32_t operation = getReg(registers, 0);
+    BitData block = getReg(registers, 1);
+    BitData result;
+
+    switch (operation) {
+        case SYS_OPEN:
+            result = sysOpen(memory, block);
+            break;
+
+        case SYS_CLOSE:
+            result = sysClose(memory, block);
+            break;
+
+        case SYS_WRITE:
+            result = sysTransfer(memory, block, false);
+            break;
+
+        case SYS_READ:
+            result = sysTransfer(memory, block, true);
+            break;
+
+        case SYS_EXIT:
+            exited = true;
+            exitStatus = getParam(memory, block, 0) == ADP_STOPPED_APPLICATION_EXIT
+                         ? (int) getParam(memory, block, 1)
+                         : EXIT_FAILURE;
+            return;
+
+        default:
+            throwFatalWithArgs("Unsupported semihosting operation <0x%x>!", operation);
+    }
+
+    setReg(registers, 0, true, result);
+}
+
+/// Checks whether the guest has asked to stop through [SYS_EXIT].
+/// @returns Whether the guest has exited.
+bool hasExited(void) {
+    return exited;
+}
+
+/// Gets the status the guest exited with.
+/// @returns The exit status, only meaningful once [hasExited].
+int getExitStatus(void) {
+    return exitStatus;
+}
+
+/// Closes any files the guest left open and forgets that it exited, before running a fresh program.
+void resetSemihosting(void) {
+    for (size_t i = 0; i < MAX_SEMIHOSTING_FILES; i++) {
+        if (files[i].open && files[i].owned) close(files[i].fd);
+        files[i].open = false;
+    }
+    exited = false;
+    exitStatus = EXIT_SUCCESS;
+}
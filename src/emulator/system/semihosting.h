@@ -0,0 +1,52 @@
+///
+/// semihosting.h
+/// Serves guest requests for host file and process operations, made through [SEMIHOSTING_HLT].
+///
+
+#ifndef EMULATOR_SEMIHOSTING_H
+#define EMULATOR_SEMIHOSTING_H
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "const.h"
+#include "error.h"
+#include "memory.h"
+#include "registers.h"
+#include "uartDevice.h"
+#include "watchpoint.h"
+
+/// The maximum number of host files the guest may hold open at once.
+#define MAX_SEMIHOSTING_FILES 16
+
+/// Opens a host file. Block: path address, mode (0-11, as [fopen] "r" to "a+b"), path length.
+#define SYS_OPEN              0x01
+
+/// Closes a handle. Block: handle.
+#define SYS_CLOSE             0x02
+
+/// Writes from guest memory to a handle. Block: handle, buffer address, length.
+#define SYS_WRITE             0x05
+
+/// Reads from a handle into guest memory. Block: handle, buffer address, length.
+#define SYS_READ              0x06
+
+/// Stops the guest. Block: reason, exit status.
+#define SYS_EXIT              0x18
+
+/// The [SYS_EXIT] reason for the guest exiting normally, with an exit status.
+#define ADP_STOPPED_APPLICATION_EXIT 0x20026
+
+void semihost(Registers registers, Memory memory);
+
+bool hasExited(void);
+
+int getExitStatus(void);
+
+void resetSemihosting(void);
+
+#endif // EMULATOR_SEMIHOSTING_H
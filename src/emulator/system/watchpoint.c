@@ -0,0 +1,255 @@
+///
+/// watchpoint.c
+/// Watchpoints on writes to virtual memory, caught by write-protecting the host pages backing it.
+///
+
+#include "watchpoint.h"
+
+/// A watched range of virtual memory.
+typedef struct {
+    /// The first address of the range.
+    size_t address;
+
+    /// The number of bytes in the range.
+    size_t length;
+} Watchpoint;
+
+/// The watched ranges.
+static Watchpoint watchpoints[MAX_WATCHPOINTS];
+
+/// The number of ranges in [watchpoints].
+static size_t watchpointCount = 0;
+
+/// The virtual memory being watched, or [NULL] if none.
+static uint8_t *watchedMemory = NULL;
+
+/// The size of a host page.
+static size_t pageSize = 0;
+
+/// The disposition of [SIGSEGV] before the first watchpoint, restored for faults which are not ours.
+static struct sigaction previousAction;
+
+/// Whether a write to a watched page has been let through, but not yet reported by [finishWatchpoint].
+static volatile sig_atomic_t pending = 0;
+
+/// The pages unprotected to let the pending write through.
+static uint8_t *pendingPages[MAX_PENDING_PAGES];
+
+/// The number of pages in [pendingPages].
+static volatile sig_atomic_t pendingPageCount = 0;
+
+/// Whether the pending write is a transfer let through by [watchTransfer], which unprotected every watchpoint.
+static bool pendingTransfer = false;
+
+/// The first address of the pending write.
+static size_t pendingAddress;
+
+/// The number of bytes from [pendingAddress] the pending write may have touched.
+static size_t pendingLength;
+
+/// The 64 bits at [pendingAddress] before the pending write.
+static BitData pendingOldValue;
+
+/// The last write which touched a watched range.
+static WatchpointHit lastHit;
+
+/// Whether [lastHit] has yet to be taken.
+static bool hit = false;
+
+/// Reads up to 64 bits of virtual memory as little-endian, without going through [readMem].
+/// @param address The address to read.
+/// @returns The value at [address], with any bytes beyond the end of RAM as zero.
+static BitData peek(size_t address) {
+    BitData value = 0;
+    for (size_t i = 0; i < sizeof(BitData) && address + i < MEMORY_SIZE; i++) {
+        value |= (BitData) watchedMemory[address + i] << i * 8;
+    }
+    return value;
+}
+
+/// Write-protects, or unprotects, the host pages backing [length] bytes of virtual memory from [address].
+/// @param address The first address of the range.
+/// @param length The number of bytes in the range.
+/// @param protection The new protection of the pages.
+static void protectRange(size_t address, size_t length, int protection) {
+    uintptr_t start = ((uintptr_t) watchedMemory + address) & ~(pageSize - 1);
+    uintptr_t end = (uintptr_t) watchedMemory + address + length;
+    assertFatal(mprotect((void *) start, end - start, protection) == 0, "<Watchpoint> Unable to protect memory!");
+}
+
+/// Lets a write to a watched page through, remembering it for [finishWatchpoint] to report.
+/// Faults outside the watched memory restore the previous disposition, so that they are raised again as before.
+/// @param signal The signal number, i.e., [SIGSEGV].
+/// @param info The details of the fault.
+/// @param context The interrupted context.
+static void handleFault(unused int signal, siginfo_t *info, unused void *context) {
+    uint8_t *address = (uint8_t *) info->si_addr;
+    if (watchedMemory == NULL || address < watchedMemory || address >= watchedMemory + MEMORY_SIZE
+        || pendingPageCount == MAX_PENDING_PAGES) {
+        sigaction(SIGSEGV, &previousAction, NULL);
+        return;
+    }
+
+    if (!pending) {
+        pendingAddress = address - watchedMemory;
+        pendingLength = sizeof(BitData);
+        pendingOldValue = peek(pendingAddress);
+        pending = 1;
+    }
+
+    // Returning retries the write, which now succeeds.
+    uint8_t *page = (uint8_t *) ((uintptr_t) address & ~(pageSize - 1));
+    pendingPages[pendingPageCount++] = page;
+    mprotect(page, pageSize, PROT_READ | PROT_WRITE);
+}
+
+/// Parses a range to watch, given as <address> or <address:length> in bytes, in decimal or hexadecimal (0x).
+/// A bare address watches the 64 bits from it.
+/// @param text The range to parse.
+/// @param[out] address The first address of the range.
+/// @param[out] length The number of bytes in the range.
+/// @returns Whether [text] is a valid range.
+bool parseWatchpoint(const char *text, size_t *address, size_t *length) {
+    char *end;
+    *address = strtoull(text, &end, 0);
+    if (end == text) return false;
+
+    *length = sizeof(BitData);
+    if (*end == ':') {
+        const char *start = end + 1;
+        *length = strtoull(start, &end, 0);
+        if (end == start) return false;
+    }
+
+    return *end == '\0' && *length > 0 && *address < MEMORY_SIZE && *length <= MEMORY_SIZE - *address;
+}
+
+/// Watches [length] bytes of [memory] from [address] for writes.
+/// Only the host pages covering the range are protected, so accesses elsewhere cost nothing.
+/// @param memory The virtual memory to watch, which must be the same for every watchpoint.
+/// @param address The first address of the range.
+/// @param length The number of bytes in the range.
+/// @returns Whether there was room for another watchpoint.
+bool addWatchpoint(Memory memory, size_t address, size_t length) {
+    if (watchpointCount == MAX_WATCHPOINTS) return false;
+    assertFatal(watchedMemory == NULL || watchedMemory == memory, "<Watchpoint> Can only watch one memory at once!");
+    assertFatalWithArgs(length > 0 && address < MEMORY_SIZE && length <= MEMORY_SIZE - address,
+                        "<Watchpoint> Received out-of-bound range at address 0x%zx!", address);
+
+    if (watchedMemory == NULL) {
+        pageSize = sysconf(_SC_PAGESIZE);
+        watchedMemory = memory;
+
+        struct sigaction action = { .sa_sigaction = handleFault, .sa_flags = SA_SIGINFO };
+        sigemptyset(&action.sa_mask);
+        assertFatal(sigaction(SIGSEGV, &action, &previousAction) == 0, "<Watchpoint> Unable to handle faults!");
+    }
+
+    watchpoints[watchpointCount++] = (Watchpoint) { address, length };
+    protectRange(address, length, PROT_READ);
+    return true;
+}
+
+/// Removes all watchpoints, making the watched memory writable again.
+void clearWatchpoints(void) {
+    if (watchedMemory == NULL) return;
+
+    for (size_t i = 0; i < watchpointCount; i++) {
+        protectRange(watchpoints[i].address, watchpoints[i].length, PROT_READ | PROT_WRITE);
+    }
+    sigaction(SIGSEGV, &previousAction, NULL);
+
+    watchpointCount = 0;
+    watchedMemory = NULL;
+    pending = 0;
+    pendingTransfer = false;
+    pendingPageCount = 0;
+    hit = false;
+}
+
+/// Lets the host write [length] bytes of [memory] from [address] on the guest's behalf, remembering it for
+/// [finishWatchpoint] to report. The kernel fails writes into protected pages rather than faulting, so such
+/// writes, e.g. [read] into guest memory, must be announced here instead of being caught by [handleFault].
+/// @param memory The virtual memory about to be written.
+/// @param address The first address about to be written.
+/// @param length The number of bytes about to be written.
+void watchTransfer(Memory memory, size_t address, size_t length) {
+    if (memory != watchedMemory || length == 0 || pending) return;
+
+    // Only pages shared with a watchpoint are protected, so a transfer clear of them needs no help.
+    uintptr_t first = address / pageSize;
+    uintptr_t last = (address + length - 1) / pageSize;
+    bool shared = false;
+    for (size_t i = 0; i < watchpointCount && !shared; i++) {
+        shared = watchpoints[i].address / pageSize <= last
+                 && first <= (watchpoints[i].address + watchpoints[i].length - 1) / pageSize;
+    }
+    if (!shared) return;
+
+    // Report from the first watched byte written, if any, so the values shown are those of the watched range.
+    size_t firstWatched = address + length;
+    for (size_t i = 0; i < watchpointCount; i++) {
+        size_t start = watchpoints[i].address > address ? watchpoints[i].address : address;
+        if (start < watchpoints[i].address + watchpoints[i].length && start < firstWatched) firstWatched = start;
+    }
+    pendingAddress = firstWatched < address + length ? firstWatched : address;
+    pendingLength = address + length - pendingAddress;
+    pendingOldValue = peek(pendingAddress);
+
+    for (size_t i = 0; i < watchpointCount; i++) {
+        protectRange(watchpoints[i].address, watchpoints[i].length, PROT_READ | PROT_WRITE);
+    }
+    pendingTransfer = true;
+    pending = 1;
+}
+
+/// Checks whether a write to a watched page is waiting for [finishWatchpoint].
+/// @returns Whether a write is pending.
+bool isWatchpointPending(void) {
+    return pending;
+}
+
+/// Reports the pending write if it touched a watched range, not just a watched page, then watches its pages again.
+/// @param pc The address of the instruction which wrote.
+void finishWatchpoint(BitData pc) {
+    for (size_t i = 0; i < watchpointCount; i++) {
+        Watchpoint *watchpoint = &watchpoints[i];
+        if (pendingAddress < watchpoint->address + watchpoint->length
+            && watchpoint->address < pendingAddress + pendingLength) {
+            lastHit = (WatchpointHit) { pc, pendingAddress, pendingOldValue, peek(pendingAddress) };
+            hit = true;
+            break;
+        }
+    }
+
+    for (sig_atomic_t i = 0; i < pendingPageCount; i++) {
+        assertFatal(mprotect(pendingPages[i], pageSize, PROT_READ) == 0, "<Watchpoint> Unable to protect memory!");
+    }
+    if (pendingTransfer) {
+        for (size_t i = 0; i < watchpointCount; i++) {
+            protectRange(watchpoints[i].address, watchpoints[i].length, PROT_READ);
+        }
+    }
+    pendingTransfer = false;
+    pendingPageCount = 0;
+    pending = 0;
+}
+
+/// Takes the last write which touched a watched range, if it has not been taken already.
+/// @param[out] watchpointHit The [WatchpointHit], if any.
+/// @returns Whether there was a hit to take.
+bool takeWatchpointHit(WatchpointHit *watchpointHit) {
+    if (!hit) return false;
+    *watchpointHit = lastHit;
+    hit = false;
+    return true;
+}
+
+/// Formats a [WatchpointHit] for display.
+/// @param watchpointHit The [WatchpointHit] to format.
+/// @param buffer The buffer to write to.
+/// @param size The size of [buffer].
+void formatWatchpointHit(const WatchpointHit *watchpointHit, char *buffer, size_t size) {
+    snprintf(buffer, size, "Watchpoint at 0x%zx written by PC 0x%" PRIx64 ": 0x%016" PRIx64 " -> 0x%016" PRIx64,
+             watchpointHit->address, watchpointHit->pc, watchpointHit->oldValue, watchpointHit->newValue);
+}
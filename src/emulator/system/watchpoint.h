@@ -0,0 +1,60 @@
+///
+/// watchpoint.h
+/// Watchpoints on writes to virtual memory, caught by write-protecting the host pages backing it.
+///
+
+#ifndef EMULATOR_WATCHPOINT_H
+#define EMULATOR_WATCHPOINT_H
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "const.h"
+#include "error.h"
+#include "memory.h"
+
+/// The maximum number of watchpoints at once.
+#define MAX_WATCHPOINTS   16
+
+/// The maximum number of pages a single instruction may write to.
+#define MAX_PENDING_PAGES 4
+
+/// A write which touched a watched range.
+typedef struct {
+    /// The address of the instruction which wrote.
+    BitData pc;
+
+    /// The first address written to.
+    size_t address;
+
+    /// The 64 bits at [address] before the write.
+    BitData oldValue;
+
+    /// The 64 bits at [address] after the write.
+    BitData newValue;
+} WatchpointHit;
+
+bool parseWatchpoint(const char *text, size_t *address, size_t *length);
+
+bool addWatchpoint(Memory memory, size_t address, size_t length);
+
+void clearWatchpoints(void);
+
+void watchTransfer(Memory memory, size_t address, size_t length);
+
+bool isWatchpointPending(void);
+
+void finishWatchpoint(BitData pc);
+
+bool takeWatchpointHit(WatchpointHit *hit);
+
+void formatWatchpointHit(const WatchpointHit *hit, char *buffer, size_t size);
+
+#endif // EMULATOR_WATCHPOINT_H
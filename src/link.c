@@ -0,0 +1,41 @@
+///
+/// link.c
+/// Links relocatable objects from the assembler into an AArch64 binary file.
+///
+
+#include "link.h"
+
+/// The entrypoint to the linker program.
+/// @param argc Number of arguments. Should be at least 3.
+/// @param argv Arguments. In order: executable name, objects in, and binary out.
+/// @return Program exit code.
+/// @example \code ./link main.o lib.o out.bin \endcode
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        printf("Usage: ./link code.o... out.bin\n");
+        return EXIT_FAILURE;
+    }
+
+    size_t count = argc - 2;
+    Object *objects = malloc(count * sizeof(Object));
+    assertFatalNotNull(objects, "<Memory> Unable to allocate objects!");
+    for (size_t i = 0; i < count; i++) {
+        loadObject(&objects[i], argv[i + 1]);
+    }
+
+    size_t imageCount;
+    Instruction *image = linkObjects(objects, count, &imageCount);
+
+    FILE *out = fopen(argv[argc - 1], "wb");
+    assertFatalNotNullWithArgs(out, "Unable to open output file <%s>!", argv[argc - 1]);
+    assertFatal(fwrite(image, sizeof(Instruction), imageCount, out) == imageCount, "Unable to write output!");
+    fclose(out);
+
+    free(image);
+    for (size_t i = 0; i < count; i++) {
+        unloadObject(&objects[i]);
+    }
+    free(objects);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,21 @@
+///
+/// link.h
+/// Links relocatable objects from the assembler into an AArch64 binary file.
+///
+
+#ifndef LINK_H
+#define LINK_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "error.h"
+#include "linker.h"
+
+int main(int argc, char **argv);
+
+bool JUMP_ON_ERROR = false;
+jmp_buf fatalBuffer;
+char *fatalError;
+
+#endif // LINK_H
@@ -0,0 +1,245 @@
+///
+/// linker.c
+/// Combines relocatable objects into a binary, placing their sections and filling in references between them.
+///
+
+#include "linker.h"
+
+/// Maps the object file at [path] into memory, and checks that each of its parts lies within it.
+/// @param object The [Object] to load.
+/// @param path The path of the object file.
+/// @throw InvalidObject Will fatal error if the file is not a well-formed object.
+void loadObject(Object *object, const char *path) {
+    int fd = open(path, O_RDONLY);
+    assertFatalWithArgs(fd != -1, "Unable to open object file <%s>!", path);
+
+    struct stat sb;
+    assertFatal(fstat(fd, &sb) == 0, "Unable to get statistics on object file!");
+    assertFatalWithArgs((size_t) sb.st_size >= sizeof(ObjectHeader), "Object file <%s> is truncated!", path);
+
+    object->path = path;
+    object->length = sb.st_size;
+    object->data = mmap(NULL, object->length, PROT_READ, MAP_PRIVATE, fd, 0);
+    assertFatal(object->data != MAP_FAILED, "Unable to map object file!");
+    close(fd);
+
+    const ObjectHeader *header = object->header = (const ObjectHeader *) object->data;
+    assertFatalWithArgs(header->magic == OBJECT_MAGIC && header->version == OBJECT_VERSION,
+                        "File <%s> is not an object, or is from another version of the assembler!", path);
+    assertFatalWithArgs(header->stringsLength % 0x4 == 0, "Object file <%s> is misaligned!", path);
+
+    // Each part follows on from the last, so find where each starts, checking it lies within the file.
+    uint64_t offset = sizeof(ObjectHeader);
+    object->sections = (const ObjectSection *) (object->data + offset);
+    offset += (uint64_t) header->sectionCount * sizeof(ObjectSection);
+    object->symbols = (const ObjectSymbol *) (object->data + offset);
+    offset += (uint64_t) header->symbolCount * sizeof(ObjectSymbol);
+    object->relocations = (const ObjectRelocation *) (object->data + offset);
+    offset += (uint64_t) header->relocationCount * sizeof(ObjectRelocation);
+    object->strings = object->data + offset;
+    offset += header->stringsLength;
+    object->contents = object->data + offset;
+    assertFatalWithArgs(offset <= object->length, "Object file <%s> is truncated!", path);
+
+    for (uint32_t i = 0; i < header->sectionCount; i++) {
+        const ObjectSection *section = &object->sections[i];
+        assertFatalWithArgs(section->size % 0x4 == 0 && memchr(section->name, '\0', SECTION_NAME_LENGTH) != NULL,
+                            "Object file <%s> has a malformed section!", path);
+        offset += section->size;
+    }
+    assertFatalWithArgs(offset <= object->length, "Object file <%s> is truncated!", path);
+
+    // Names must end within the string table, and references must be to parts which exist.
+    assertFatalWithArgs(header->symbolCount == 0 || header->stringsLength > 0,
+                        "Object file <%s> has a malformed symbol!", path);
+    for (uint32_t i = 0; i < header->symbolCount; i++) {
+        const ObjectSymbol *symbol = &object->symbols[i];
+        bool valid = symbol->name < header->stringsLength
+                     && memchr(object->strings + symbol->name, '\0', header->stringsLength - symbol->name) != NULL
+                     && (symbol->section == UNDEFINED_SECTION
+                         || (symbol->section < header->sectionCount
+                             && symbol->value <= object->sections[symbol->section].size));
+        assertFatalWithArgs(valid, "Object file <%s> has a malformed symbol!", path);
+    }
+    for (uint32_t i = 0; i < header->relocationCount; i++) {
+        const ObjectRelocation *relocation = &object->relocations[i];
+        bool valid = relocation->section < header->sectionCount
+                     && relocation->offset % 0x4 == 0
+                     && relocation->offset < object->sections[relocation->section].size
+                     && relocation->symbol < header->symbolCount
+                     && relocation->type < sizeof(relocationFields) / sizeof(RelocationField);
+        assertFatalWithArgs(valid, "Object file <%s> has a malformed relocation!", path);
+    }
+
+    object->sectionAddresses = malloc(header->sectionCount * sizeof(BitData));
+    assertFatalNotNull(object->sectionAddresses, "<Memory> Unable to allocate section addresses!");
+}
+
+/// Unmaps an [Object] loaded by [loadObject].
+/// @param object The [Object] to unload.
+void unloadObject(Object *object) {
+    free(object->sectionAddresses);
+    munmap((void *) object->data, object->length);
+}
+
+/// Performs [strcmp] on the [name]s of [GlobalSymbol]s, but takes in [void *]s.
+/// @param v1 The first item.
+/// @param v2 The second item.
+/// @returns [int] of comparison.
+static int globalSymbolCmp(const void *v1, const void *v2) {
+    const GlobalSymbol *p1 = (const GlobalSymbol *) v1;
+    const GlobalSymbol *p2 = (const GlobalSymbol *) v2;
+    return strcmp(p1->name, p2->name);
+}
+
+/// Places every section of [objects] in the binary. Sections of the same name are placed together, in the order in
+/// which the objects were given, and each name is placed in the order in which it first appears.
+/// @param objects The [Object]s to place, whose [Object.sectionAddresses] are set.
+/// @param count The number of [objects].
+/// @returns The number of bytes in the binary.
+static BitData placeSections(Object *objects, size_t count) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) total += objects[i].header->sectionCount;
+
+    // Gather the names of the sections, in the order in which each first appears.
+    const char **names = malloc(total * sizeof(char *));
+    assertFatalNotNull(names, "<Memory> Unable to allocate section names!");
+    size_t nameCount = 0;
+    for (size_t i = 0; i < count; i++) {
+        for (uint32_t j = 0; j < objects[i].header->sectionCount; j++) {
+            const char *name = objects[i].sections[j].name;
+            size_t k = 0;
+            while (k < nameCount && strcmp(names[k], name)) k++;
+            if (k == nameCount) names[nameCount++] = name;
+        }
+    }
+
+    BitData address = 0x0;
+    for (size_t k = 0; k < nameCount; k++) {
+        for (size_t i = 0; i < count; i++) {
+            for (uint32_t j = 0; j < objects[i].header->sectionCount; j++) {
+                if (strcmp(objects[i].sections[j].name, names[k])) continue;
+                objects[i].sectionAddresses[j] = address;
+                address += objects[i].sections[j].size;
+            }
+        }
+    }
+    free(names);
+
+    assertFatal(address <= MEMORY_SIZE, "Linked binary does not fit in memory!");
+    return address;
+}
+
+/// Collects the symbols defined by [objects] into a table sorted by name, for [bsearch].
+/// @param objects The placed [Object]s.
+/// @param count The number of [objects].
+/// @param[out] symbolCount The number of [GlobalSymbol]s in the table.
+/// @returns The table of [GlobalSymbol]s, to be freed by the caller.
+static GlobalSymbol *collectSymbols(const Object *objects, size_t count, size_t *symbolCount) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) total += objects[i].header->symbolCount;
+
+    GlobalSymbol *symbols = malloc(total * sizeof(GlobalSymbol));
+    assertFatalNotNull(symbols, "<Memory> Unable to allocate symbol table!");
+
+    size_t defined = 0;
+    for (size_t i = 0; i < count; i++) {
+        for (uint32_t j = 0; j < objects[i].header->symbolCount; j++) {
+            const ObjectSymbol *symbol = &objects[i].symbols[j];
+            if (symbol->section == UNDEFINED_SECTION) continue;
+            symbols[defined++] = (GlobalSymbol) {
+                .name = objects[i].strings + symbol->name,
+                .address = objects[i].sectionAddresses[symbol->section] + symbol->value,
+                .ambiguous = false
+            };
+        }
+    }
+
+    // Merge symbols defined more than once, so that only references to them fail.
+    qsort(symbols, defined, sizeof(GlobalSymbol), globalSymbolCmp);
+    size_t unique = 0;
+    for (size_t i = 0; i < defined; i++) {
+        if (unique > 0 && !strcmp(symbols[unique - 1].name, symbols[i].name)) {
+            symbols[unique - 1].ambiguous = true;
+        } else {
+            symbols[unique++] = symbols[i];
+        }
+    }
+
+    *symbolCount = unique;
+    return symbols;
+}
+
+/// Fills in the field of the instruction at [address] with the word offset to [target].
+/// @param image The binary being linked.
+/// @param address The address of the instruction.
+/// @param target The address of the symbol the instruction refers to.
+/// @param type The [RelocationType] of the field.
+/// @param name The name of the symbol, for errors.
+/// @throw OutOfRange Will fatal error if the offset does not fit in the field.
+static void relocate(Instruction *image, BitData address, BitData target, RelocationType type, const char *name) {
+    const RelocationField *field = &relocationFields[type];
+    assertFatalWithArgs(target % 0x4 == 0, "Label <%s> is not word-aligned!", name);
+
+    int64_t offset = ((int64_t) target - (int64_t) address) / 4;
+    int64_t limit = (int64_t) 1 << (field->width - 1);
+    assertFatalWithArgs(offset >= -limit && offset < limit,
+                        "Offset to label <%s> does not fit in %d bits!", name, field->width);
+
+    Instruction mask = maskr(field->width) << field->shift;
+    Instruction value = truncater(offset, field->width) << field->shift;
+    image[address / 0x4] = (image[address / 0x4] & ~mask) | value;
+}
+
+/// Links [objects] into a binary. Their sections are placed by [placeSections], then each relocation is filled in
+/// from the symbol it refers to, whether that is defined by its own object or by exactly one other.
+/// @param objects The [Object]s to link, loaded by [loadObject].
+/// @param count The number of [objects].
+/// @param[out] imageCount The number of [Instruction]s in the binary.
+/// @returns The binary, to be freed by the caller.
+/// @throw UndefinedLabel Will fatal error if some referenced label is not defined by exactly one object.
+Instruction *linkObjects(Object *objects, size_t count, size_t *imageCount) {
+    BitData size = placeSections(objects, count);
+    Instruction *image = malloc(size);
+    assertFatalNotNull(image, "<Memory> Unable to allocate binary!");
+
+    // Copy each section into its place.
+    for (size_t i = 0; i < count; i++) {
+        const char *contents = objects[i].contents;
+        for (uint32_t j = 0; j < objects[i].header->sectionCount; j++) {
+            memcpy((char *) image + objects[i].sectionAddresses[j], contents, objects[i].sections[j].size);
+            contents += objects[i].sections[j].size;
+        }
+    }
+
+    size_t symbolCount;
+    GlobalSymbol *symbols = collectSymbols(objects, count, &symbolCount);
+
+    for (size_t i = 0; i < count; i++) {
+        const Object *object = &objects[i];
+        for (uint32_t j = 0; j < object->header->relocationCount; j++) {
+            const ObjectRelocation *relocation = &object->relocations[j];
+            const ObjectSymbol *symbol = &object->symbols[relocation->symbol];
+            const char *name = object->strings + symbol->name;
+
+            // A symbol the object defines itself needs no lookup.
+            BitData target;
+            if (symbol->section != UNDEFINED_SECTION) {
+                target = object->sectionAddresses[symbol->section] + symbol->value;
+            } else {
+                GlobalSymbol key = { .name = name };
+                GlobalSymbol *global = bsearch(&key, symbols, symbolCount, sizeof(GlobalSymbol), globalSymbolCmp);
+                assertFatalNotNullWithArgs(global, "No mapping for label named <%s>!", name);
+                assertFatalWithArgs(!global->ambiguous, "Label <%s> is defined by more than one object!", name);
+                target = global->address;
+            }
+
+            BitData address = object->sectionAddresses[relocation->section] + relocation->offset;
+            relocate(image, address, target, relocation->type, name);
+        }
+    }
+
+    free(symbols);
+    *imageCount = size / sizeof(Instruction);
+    return image;
+}
@@ -0,0 +1,74 @@
+///
+/// linker.h
+/// Combines relocatable objects into a binary, placing their sections and filling in references between them.
+///
+
+#ifndef LINKER_LINKER_H
+#define LINKER_LINKER_H
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "const.h"
+#include "error.h"
+#include "objectFormat.h"
+
+/// An object file mapped into memory, with views of each of its parts.
+typedef struct {
+    /// The path of the object file.
+    const char *path;
+
+    /// The whole of the object file.
+    const char *data;
+
+    /// The number of bytes in [data].
+    size_t length;
+
+    /// The header of the object.
+    const ObjectHeader *header;
+
+    /// The [ObjectSection]s of the object.
+    const ObjectSection *sections;
+
+    /// The [ObjectSymbol]s of the object.
+    const ObjectSymbol *symbols;
+
+    /// The [ObjectRelocation]s of the object.
+    const ObjectRelocation *relocations;
+
+    /// The string table of the object.
+    const char *strings;
+
+    /// The contents of each section, in order.
+    const char *contents;
+
+    /// The address of each section in the binary, once it has been placed.
+    BitData *sectionAddresses;
+} Object;
+
+/// A symbol defined by some object, as seen by every object.
+typedef struct {
+    /// The name of the symbol, owned by its object.
+    const char *name;
+
+    /// The address of the symbol in the binary.
+    BitData address;
+
+    /// Whether more than one object defines the symbol, so that references to it are ambiguous.
+    bool ambiguous;
+} GlobalSymbol;
+
+void loadObject(Object *object, const char *path);
+
+void unloadObject(Object *object);
+
+Instruction *linkObjects(Object *objects, size_t count, size_t *imageCount);
+
+#endif // LINKER_LINKER_H